@@ -0,0 +1,59 @@
+#ifndef __BENCHMARK_REPORT_HPP__
+#define __BENCHMARK_REPORT_HPP__
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// The benchmark's measurements and the JSON and CSV reports written from them.
+
+struct Result {
+    string benchmark;
+    string config;
+    double value;
+    string unit;
+};
+
+//a CSV field, quoted when it holds a comma, quote or line break, quotes inside doubled
+inline string csv_field(const string & field) {
+    if (field.find_first_of(",\"\r\n") == string::npos) {
+        return field;
+    }
+    string quoted = "\"";
+    for (unsigned i = 0; i < field.size(); ++i) {
+        if (field[i] == '"') {
+            quoted += '"';
+        }
+        quoted += field[i];
+    }
+    return quoted + "\"";
+}
+
+inline string to_json(const vector<Result> & results, unsigned seed) {
+    stringstream json;
+    json.precision(10);
+    json << "{\n  \"seed\": " << seed << ",\n  \"results\": [\n";
+    for (unsigned i = 0; i < results.size(); ++i) {
+        const Result & r = results.at(i);
+        json << "    {\"benchmark\": \"" << r.benchmark << "\", \"config\": \"" << r.config
+             << "\", \"value\": " << r.value << ", \"unit\": \"" << r.unit << "\"}"
+             << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    json << "  ]\n}\n";
+    return json.str();
+}
+
+inline string to_csv(const vector<Result> & results) {
+    stringstream csv;
+    csv.precision(10);
+    csv << "benchmark,config,value,unit\n";
+    for (unsigned i = 0; i < results.size(); ++i) {
+        const Result & r = results.at(i);
+        csv << csv_field(r.benchmark) << ',' << csv_field(r.config) << ',' << r.value << ',' << csv_field(r.unit) << "\n";
+    }
+    return csv.str();
+}
+
+#endif
@@ -0,0 +1,28 @@
+#include "Gamemode.hpp"
+
+#include <cstdio>
+
+Gamemode::Gamemode(const Config & config, bool headless):
+renderer(nullptr), window(nullptr), lastTime(0), headless(headless), config(config), rng(config.seed) {
+
+    if (headless) { //nothing is ever drawn, so SDL is never initialized
+        return;
+    }
+
+    if(SDL_Init(SDL_INIT_VIDEO) != 0) {
+        fprintf(stderr, "Could not init SDL: %s\n", SDL_GetError());
+        throw("Could not init SDL\n");
+    }
+    window = SDL_CreateWindow("Pong",SDL_WINDOWPOS_UNDEFINED,SDL_WINDOWPOS_UNDEFINED,WIDTH,HEIGHT,0);
+    if(!window) {
+        fprintf(stderr, "Could not create window\n");
+        throw("Could not create window\n");
+    }
+    renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
+    if(!renderer) {
+        fprintf(stderr, "Could not create renderer\n");
+        throw("Could not create renderer\n");
+    }
+
+    gameRend = GameRenderer();
+}
@@ -1,12 +1,12 @@
 #ifndef __GAMEMODE_HPP__
 #define __GAMEMODE_HPP__
 
-#include "../sdl2lib/include/SDL2/SDL.h"
-#include "../sdl2lib/include/SDL2/SDL_ttf.h"
+#include "SDL2/SDL.h"
+#include "SDL2/SDL_ttf.h"
 #include "../Pong/GameRenderer.hpp"
 #include "../definitions.hpp"
-
-#include <ctime>
+#include "../config.hpp"
+#include "../NeuralNetwork/Random.hpp"
 
 class Gamemode {
 protected:
@@ -17,27 +17,13 @@ protected:
 
     int frameCount, timerFPS, lastFrame, fps;
     int lastTime;
-public:
-    Gamemode(): lastTime(0) {
-        srand(time(0));
 
-        if(SDL_Init(SDL_INIT_VIDEO) != 0) {
-            fprintf(stderr, "Could not init SDL: %s\n", SDL_GetError());
-            throw("Could not init SDL\n");
-        }
-        window = SDL_CreateWindow("Pong",SDL_WINDOWPOS_UNDEFINED,SDL_WINDOWPOS_UNDEFINED,WIDTH,HEIGHT,0);
-        if(!window) {
-            fprintf(stderr, "Could not create window\n");
-            throw("Could not create window\n");
-        }
-        renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_SOFTWARE);
-        if(!renderer) {
-            fprintf(stderr, "Could not create renderer\n");
-            throw("Could not create renderer\n");
-        }
+    bool headless; //no SDL window, renderer or frame cap
 
-        gameRend = GameRenderer();
-    }
+    Config config; //a run with the same config, seed included, makes the same random choices
+    Random rng;
+public:
+    Gamemode(const Config & config = Config(), bool headless = false);
     virtual ~Gamemode() {}
     virtual void update(bool &) = 0;
 };
@@ -0,0 +1,167 @@
+#include "Train.hpp"
+
+using namespace std;
+
+Train::Train(const Config & config, bool headless, unsigned max_generations, string checkpoint_path):
+Gamemode(config, headless), shown_generation(0), render_toggle(!headless), max_generations(max_generations), checkpoint_path(checkpoint_path) {
+    Controller* left_controller = new User(SDL_SCANCODE_W, SDL_SCANCODE_S);
+    left_wall= new Player(left_controller, 32,(HEIGHT/2)-(HEIGHT/8),(HEIGHT),22);
+    gameRend.add(left_wall);
+
+    if (!headless && config.islands > 1) {
+        throw("only headless training evolves islands\n");
+    }
+    model = new IslandModel(config); //seeded with config.seed, a resumed run keeps the seed it was started with
+    handler = &model->island(0);
+    if (checkpoint_path.empty() || !model->resume(checkpoint_path)) {
+        model->init_networks();
+    }
+    if (!checkpoint_path.empty()) {
+        model->set_checkpoint(checkpoint_path, config.checkpoint_interval);
+    }
+
+    model->serve();
+
+    for (unsigned i = 0; i < config.num_rendered; ++i) {
+        rendered_players.push_back(new Player(nullptr, WIDTH-32, (HEIGHT/2)-(HEIGHT/8), (HEIGHT/config.height_ratio), 12));
+        rendered_balls.push_back(new Ball());
+        shown_indices.push_back(-1);
+    }
+}
+
+Train::~Train() {
+    if (headless) { //no one is at the console to answer, so keep every fittest network
+        if (!checkpoint_path.empty()) {
+            model->checkpoint(checkpoint_path);
+        }
+        model->save(config.num_fittest);
+        delete model; //waits for the last checkpoints
+        delete left_wall;
+        delete_rendered();
+        return;
+    }
+
+    SDL_DestroyRenderer(renderer);
+    SDL_DestroyWindow(window);
+    SDL_Quit();
+
+    char input = 0;
+    while (input != 'y' && input != 'n') {
+        cout << "would you like to save? y/n: " << endl;
+        cin >> input;
+        cout << endl;
+    }
+    if (input == 'y') {
+        unsigned num_input = -1;
+        while (num_input < 0 ||  num_input > config.num_fittest) {
+            cout << "How many networks would you like to save? Upper Limit: " << config.num_fittest << endl;
+            cin >> num_input;
+            cout << endl;
+        }
+        model->save(num_input);
+    }
+    delete model;
+    delete left_wall;
+    delete_rendered();
+}
+
+void Train::update(bool & running) {
+    if (headless) {
+        update_headless(running);
+        return;
+    }
+
+    lastFrame=SDL_GetTicks();
+    if(lastFrame>=(lastTime+1000)) {
+        lastTime=lastFrame;
+        fps=frameCount;
+        frameCount=0;
+    }
+
+    update_wall();
+    handler->update();
+    input(running);
+    // left_wall->get_input();
+
+    //render(frameCount, timerFPS, lastFrame, renderer, left_paddle, right_paddle, ball, message);
+    if (render_toggle) {
+        gameRend.render_all(renderer, frameCount, timerFPS, lastFrame, rendered_objects());
+    }
+}
+
+void Train::update_headless(bool & running) {
+    if(left_wall->getY()<0) left_wall->setY(0);
+    if(left_wall->getY() + left_wall->getH()>HEIGHT) left_wall->setY(HEIGHT-left_wall->getH());
+
+    SDL_Rect lp = left_wall->getRect();
+    model->evaluate(lp.x, lp.y, lp.w, lp.h, config.evaluation_frames);
+
+    if (max_generations != 0 && model->get_nth_generation() > max_generations) {
+        running = false;
+    }
+}
+
+void Train::update_wall() {
+    if(left_wall->getY()<0) left_wall->setY(0);                                                         // adds boundries for left paddle
+    if(left_wall->getY() + left_wall->getH()>HEIGHT) left_wall->setY(HEIGHT-left_wall->getH());
+
+    SDL_Rect lp = left_wall->getRect();
+    handler->bounce_off_wall(lp.x, lp.y, lp.w, lp.h);
+}
+
+vector<Object*> Train::rendered_objects() {
+    vector<Object*> objects;
+    World & world = handler->get_world();
+    vector<unsigned> & indices = handler->get_rendered_indices();
+    bool new_generation = shown_generation != handler->get_nth_generation();
+    shown_generation = handler->get_nth_generation();
+
+    for (unsigned i = 0; i < indices.size() && i < rendered_players.size(); ++i) {
+        unsigned index = indices.at(i);
+        if (!world.alive[index]) {
+            continue;
+        }
+        Player* player = rendered_players.at(i);
+        Ball* ball = rendered_balls.at(i);
+        if (new_generation || shown_indices.at(i) != index) { //a different network, so a different color
+            player->randomize_color(rng);
+            ball->set_color(player->get_color());
+            shown_indices.at(i) = index;
+        }
+        player->setX(world.paddle_x);
+        player->setY(world.paddle_y[index]);
+        ball->setX(world.ball_x[index]);
+        ball->setY(world.ball_y[index]);
+
+        objects.push_back(player);
+        objects.push_back(ball);
+    }
+    return objects;
+}
+
+void Train::delete_rendered() {
+    for (unsigned i = 0; i < rendered_players.size(); ++i) {
+        delete rendered_players.at(i);
+        delete rendered_balls.at(i);
+    }
+}
+
+void Train::input(bool &running) {
+    SDL_Event e;
+    const Uint8 *keystates = SDL_GetKeyboardState(NULL);
+    while(SDL_PollEvent(&e)) if(e.type==SDL_QUIT) running = false;                          //allows for key inputs
+    if(keystates[SDL_SCANCODE_ESCAPE]) {
+        running = false;
+    }
+    if (keystates[SDL_SCANCODE_T]) {
+        cout << "render toggled" << endl;
+        render_toggle = !render_toggle;
+        while (keystates[SDL_SCANCODE_T]) {
+            while(SDL_PollEvent(&e));
+            keystates = SDL_GetKeyboardState(NULL);
+        }
+    }
+
+
+    return;
+}
@@ -2,8 +2,8 @@
 #define __TRAIN_HPP__
 
 #include <iostream>
-#include "../sdl2lib/include/SDL2/SDL.h"
-#include "../sdl2lib/include/SDL2/SDL_ttf.h"
+#include "SDL2/SDL.h"
+#include "SDL2/SDL_ttf.h"
 #include "Gamemode.hpp"
 #include "../Pong/Object.hpp"
 #include "../Pong/Controller.hpp"
@@ -15,10 +15,12 @@
 #include "../NeuralNetwork/Sensor.hpp"
 #include "../NeuralNetwork/AI.hpp"
 #include "../NeuralNetwork/NetworkHandler.hpp"
+#include "../NeuralNetwork/IslandModel.hpp"
 
 #include <ctime>
 #include <math.h>
 #include <iostream>
+#include <string>
 #include <vector>
 
 #include "../definitions.hpp"
@@ -28,114 +30,44 @@ using namespace std;
 class Train: public Gamemode {
 friend class TrainTests;
 private:
-    NetworkHandler * handler;
+    IslandModel * model;      //the same run trainer makes of the config, one island is a single population
+    NetworkHandler * handler; //the first island, the one that is drawn
     Player* left_wall;
 
+    //the handler only keeps raw state, these draw the pairs it picks for rendering
+    vector<Player*> rendered_players;
+    vector<Ball*> rendered_balls;
+    vector<unsigned> shown_indices;
+    unsigned shown_generation;
+
     bool render_toggle;
+    unsigned max_generations; //headless only, 0 trains until the process is stopped
+    string checkpoint_path;   //headless only, empty never checkpoints
 
 public:
-    Train(): Gamemode(), render_toggle(true) {
-        Controller* left_controller = new User(SDL_SCANCODE_W, SDL_SCANCODE_S);
-        left_wall= new Player(left_controller, 32,(HEIGHT/2)-(HEIGHT/8),(HEIGHT),22);
-        gameRend.add(left_wall);
-
-        NetworkParams params(INPUTS, OUTPUTS, HIDDEN_LAYERS, HIDDEN_LAYER_SIZE);
-        handler = new NetworkHandler(params, 0.05, 1200);
-        handler->init_networks();
-
-        handler->serve();
-    }
-
-    ~Train() {
-        SDL_DestroyRenderer(renderer);
-        SDL_DestroyWindow(window);
-        SDL_Quit();
-
-        char input = 0;
-        while (input != 'y' && input != 'n') {
-            cout << "would you like to save? y/n: " << endl;
-            cin >> input;
-            cout << endl;
-        }
-        if (input == 'y') {
-            unsigned num_input = -1;
-            while (num_input < 0 ||  num_input > NUM_FITTEST) {
-                cout << "How many networks would you like to save? Upper Limit: " << NUM_FITTEST << endl;
-                cin >> num_input;
-                cout << endl;
-            }
-            handler->save(num_input);
-        }
-        delete handler;
-        delete left_wall;
-    }
-
-    virtual void update(bool & running) {
-        lastFrame=SDL_GetTicks();
-        if(lastFrame>=(lastTime+1000)) {
-            lastTime=lastFrame;
-            fps=frameCount;
-            frameCount=0;
-        }
-
-        Ball** balls = handler->getBalls();
-        for (unsigned i = 0; i < handler->size(); ++i) {
-            if (balls[i]) { //some balls are nullptr as players get killed
-                update(balls[i]);
-            }
-        }
-        handler->update();
-        input(running);
-        // left_wall->get_input();
-
-        //render(frameCount, timerFPS, lastFrame, renderer, left_paddle, right_paddle, ball, message);
-        if (render_toggle) {
-            gameRend.render_all(renderer, frameCount, timerFPS, lastFrame, handler->getObjects());
-        }
-    }
+    Train(const Config & config = Config()): Train(config, false, 0) {}
+
+    //headless training skips SDL entirely and evolves every island as fast as the CPU allows.
+    //with a checkpoint path the run is checkpointed there and resumed from it if it already exists.
+    //rendered training draws a single population, so it throws if config.islands > 1
+    Train(const Config & config, bool headless, unsigned max_generations, string checkpoint_path = "");
+
+    ~Train();
+
+    virtual void update(bool & running);
 private:
-    void update(Ball* ball){
-        SDL_Rect b1 = ball->getRect();
-        SDL_Rect lp = left_wall->getRect();
-
-        if(SDL_HasIntersection(&b1, &lp)){
-            double rel= (left_wall->getY()+(left_wall->getH()/2))-(ball->getY()+8);
-            double norm = rel/(left_wall->getH()/2);
-            double bounce = norm * (5*PI/12);
-            double num= (rand() % 360);
-            ball->setVelX((ball->getSpeed()*1)*abs(cos(num))); //sends ball at different angle based on where the ball has hit the paddle
-            ball->setVelY((ball->getSpeed())*sin(num));
-        }
-
-        if(ball->getY()<=0 || ball->getY()+16>=HEIGHT) ball->setVelY(ball->getVelY()*-1);       //check to see if ball hit top or bottom walls
-        ball->setX(ball->getVelX()+ball->getX());                                               //ball movement;
-        ball->setY(ball->getVelY()+ball->getY());
-
-        if(left_wall->getY()<0) left_wall->setY(0);                                                         // adds boundries for left paddle
-        if(left_wall->getY() + left_wall->getH()>HEIGHT) left_wall->setY(HEIGHT-left_wall->getH());
-
-        return;
-    }
-
-    void input(bool &running) {
-        SDL_Event e;
-        const Uint8 *keystates = SDL_GetKeyboardState(NULL);
-        while(SDL_PollEvent(&e)) if(e.type==SDL_QUIT) running = false;                          //allows for key inputs
-        if(keystates[SDL_SCANCODE_ESCAPE]) {
-            running = false;
-        }
-        if (keystates[SDL_SCANCODE_T]) {
-            cout << "render toggled" << endl;
-            render_toggle = !render_toggle;
-            while (keystates[SDL_SCANCODE_T]) {
-                while(SDL_PollEvent(&e));
-                keystates = SDL_GetKeyboardState(NULL);
-            }
-        }
-
-
-        return;
-    }
+    //a whole generation per call, nothing is drawn so no paddle has to wait for a frame
+    void update_headless(bool & running);
+
+    //bounces every ball off the left wall, which also moves them
+    void update_wall();
+
+    //copies the pairs the handler wants shown into the render objects
+    vector<Object*> rendered_objects();
+
+    void delete_rendered();
+
+    void input(bool &running);
 };
 
 #endif
@@ -0,0 +1,97 @@
+#include "AI.hpp"
+#include "../Pong/Player.hpp"
+
+using namespace std;
+
+AI::AI(Sensor* sensor, NeuralNetwork* nn, double speed, unsigned decision_interval):
+Controller(speed), sensor(sensor), nn(nn), decision_interval(decision_interval), frames_to_decision(0), choice(0) {
+    fixed_forward = fixed_forward_for(this->nn->get_params());
+    movement = new bool[this->nn->get_params().inputs];
+    for (unsigned i = 0; i < this->nn->get_params().inputs; ++i) {
+        movement[i] = false;
+    }
+}
+
+AI::AI(Sensor* sensor, NetworkParams & params):
+Controller(SPEED), sensor(sensor), decision_interval(DECISION_INTERVAL), frames_to_decision(0), choice(0) {
+    nn = new NeuralNetwork(params);
+    fixed_forward = fixed_forward_for(params);
+    movement = new bool[params.inputs];
+    for (unsigned i = 0; i < params.inputs; ++i) {
+        movement[i] = false;
+    }
+}
+
+AI::AI(Sensor* sensor, NetworkParams & params, NeuralNetwork* nn1, NeuralNetwork* nn2, float mutation_rate):
+Controller(0), sensor(sensor), decision_interval(DECISION_INTERVAL), frames_to_decision(0), choice(0) {
+    //cout << "breeding network" << endl;
+    nn = new NeuralNetwork(params, nn1, nn2, mutation_rate);
+    fixed_forward = fixed_forward_for(params);
+    //cout << "made network" << endl;
+    movement = new bool[params.inputs];
+    for (unsigned i = 0; i < params.inputs; ++i) {
+        movement[i] = false;
+    }
+}
+
+AI::AI(Sensor* sensor, string directory):
+sensor(sensor), decision_interval(DECISION_INTERVAL), frames_to_decision(0), choice(0) {
+    nn = new NeuralNetwork(directory);
+    fixed_forward = fixed_forward_for(nn->get_params());
+    movement = new bool[nn->num_inputs()];
+    for (unsigned i = 0; i < nn->num_inputs(); ++i) {
+        movement[i] = false;
+    }
+}
+
+AI::~AI() {
+    if(!sensor) delete sensor;
+    if(!nn) delete nn;
+    if(!movement) delete [] movement;
+}
+
+float AI::get_fitness() {
+    unsigned total = 0;
+    //cout << num_alive << ' ' << movement[0] << ' ' << movement[1] << ' ' << movement[2] << endl;
+    for (unsigned i = 0; i < nn->get_params().inputs; ++i) {
+        if (movement[i]) {
+            ++total;
+        }
+    }
+
+    return total;
+}
+
+void AI::move(Player* paddle) {
+    if (frames_to_decision == 0) {
+        sense(paddle, nn->get_inputs());
+        if (fixed_forward) {
+            fixed_forward(nn->get_genome(), nn->get_inputs(), nn->get_outputs());
+        }
+        else {
+            nn->forward_propagation();
+        }
+        choice = choose(nn->get_outputs());
+        frames_to_decision = decision_interval <= 1 ? 1 : decision_interval;
+    }
+    --frames_to_decision;
+    act(paddle, choice);
+}
+
+void AI::sense(Player* paddle, float* inputs) {
+    sensor->set_activations(paddle, inputs, nn->num_inputs());
+}
+
+void AI::act(Player* paddle, const float* outputs) {
+    act(paddle, choose(outputs));
+}
+
+void AI::act(Player* paddle, unsigned index_max) {
+    if (index_max == 0) {
+        paddle->setY(paddle->getY()-speed);
+    }
+    else if (index_max == 1) {
+        paddle->setY(paddle->getY()+speed);
+    }
+    movement[index_max] = true;
+}
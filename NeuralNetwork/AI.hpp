@@ -4,6 +4,7 @@
 #include <iostream>
 #include "../Pong/Controller.hpp"
 #include "NeuralNetwork.hpp"
+#include "FixedNetwork.hpp"
 #include "Sensor.hpp"
 #include "../definitions.hpp"
 
@@ -16,83 +17,51 @@ friend class AITests;
 private:
     Sensor* sensor;
     NeuralNetwork* nn;
+    FixedForward fixed_forward; //unrolled forward pass for nn's topology, if one is compiled
 
     bool* movement;
+
+    unsigned decision_interval; //frames each choice is repeated for
+    unsigned frames_to_decision; //until the network is asked again, 0 asks on the next move()
+    unsigned choice;             //the output move() repeats in between
 public:
 
-    AI(Sensor* sensor, NeuralNetwork* nn): Controller(SPEED), sensor(sensor), nn(nn) {
-        movement = new bool[this->nn->get_params().inputs];
-        for (unsigned i = 0; i < this->nn->get_params().inputs; ++i) {
-            movement[i] = false;
-        }
-    }
+    AI(Sensor* sensor, NeuralNetwork* nn, double speed = SPEED, unsigned decision_interval = DECISION_INTERVAL);
 
-    AI(Sensor* sensor, NetworkParams & params): Controller(SPEED), sensor(sensor) {
-        nn = new NeuralNetwork(params);
-        movement = new bool[params.inputs];
-        for (unsigned i = 0; i < params.inputs; ++i) {
-            movement[i] = false;
-        }
-    }
+    AI(Sensor* sensor, NetworkParams & params);
 
-    AI(Sensor* sensor, NetworkParams & params, NeuralNetwork* nn1, NeuralNetwork* nn2, float mutation_rate):
-    Controller(0), sensor(sensor) {
-        //cout << "breeding network" << endl;
-        nn1->forward_propagation();
-        nn2->forward_propagation();
-
-        nn = new NeuralNetwork(params, nn1, nn2, mutation_rate);
-        //cout << "made network" << endl;
-        movement = new bool[params.inputs];
-        for (unsigned i = 0; i < params.inputs; ++i) {
-            movement[i] = false;
-        }
-    }
+    AI(Sensor* sensor, NetworkParams & params, NeuralNetwork* nn1, NeuralNetwork* nn2, float mutation_rate);
 
-    AI(Sensor* sensor, string directory): sensor(sensor) {
-        nn = new NeuralNetwork(directory);
-        movement = new bool[nn->num_inputs()];
-        for (unsigned i = 0; i < nn->num_inputs(); ++i) {
-            movement[i] = false;
-        }
-    }
+    AI(Sensor* sensor, string directory);
 
-    ~AI() {
-        if(!sensor) delete sensor;
-        if(!nn) delete nn;
-        if(!movement) delete [] movement;
-    }
+    ~AI();
 
     virtual NeuralNetwork* getNetwork() {
         return nn;
     }
 
-    virtual float get_fitness() {
-        unsigned total = 0;
-        //cout << num_alive << ' ' << movement[0] << ' ' << movement[1] << ' ' << movement[2] << endl;
-        for (unsigned i = 0; i < nn->get_params().inputs; ++i) {
-            if (movement[i]) {
-                ++total;
-            }
-        }
+    virtual float get_fitness();
 
-        return total;
+    //senses and evaluates the network every decision_interval calls, and repeats its last choice in between
+    virtual void move(Player* paddle);
+
+    //the next move() decides afresh
+    void set_decision_interval(unsigned interval) {
+        decision_interval = interval == 0 ? 1 : interval;
+        frames_to_decision = 0;
     }
 
-    virtual void move(Player* paddle) {
-        sensor->set_activations(paddle, nn->get_inputs(), nn->num_inputs());
-        //cout << "after setting activations" << endl;
-        //std::cout << "moving" << std::endl;
-        // float* test = nn->get_inputs();
-        // for (unsigned i = 0; i < 7; ++i) {
-        //     std::cout << test[i] << ' ';
-        // }
-        // std::cout << '\n';
+    //writes the sensor readings for paddle into inputs (nn->num_inputs() floats)
+    void sense(Player* paddle, float* inputs);
 
-        nn->forward_propagation();
+    //moves the paddle according to the network outputs (NUM_OUTPUTS floats)
+    void act(Player* paddle, const float* outputs);
 
-        float * outputs = nn->get_outputs();
+    //moves the paddle the way output index (see choose()) says to
+    void act(Player* paddle, unsigned index);
 
+    //index of the strongest output: 0 moves up, 1 moves down, anything else stays
+    static unsigned choose(const float* outputs) {
         unsigned index_max = 1;
         for (unsigned i = 0; i < NUM_OUTPUTS; ++i) {
             //std::cout << outputs[i] << ' ';
@@ -101,14 +70,7 @@ public:
             }
         }
         //std::cout << '\n';
-
-        if (index_max == 0) {
-            paddle->setY(paddle->getY()-speed);
-        }
-        else if (index_max == 1) {
-            paddle->setY(paddle->getY()+speed);
-        }
-        movement[index_max] = true;
+        return index_max;
     }
 };
 
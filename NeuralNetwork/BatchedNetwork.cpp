@@ -0,0 +1,40 @@
+#include "BatchedNetwork.hpp"
+
+using namespace std;
+
+BatchedNetwork::BatchedNetwork(NetworkParams & params, unsigned capacity): params(params), capacity(capacity) {
+    num_layers = params.hidden_layers + 2;
+
+    unsigned gene = 0;
+    unsigned row = 0;
+    for (unsigned i = 0; i < num_layers; ++i) {
+        bias_offsets.push_back(gene);
+        activation_offsets.push_back(row);
+        gene += layer_size(i);
+        row += layer_size(i);
+    }
+    for (unsigned index = 0; index < num_layers-1; ++index) {
+        weight_offsets.push_back(gene);
+        gene += layer_size(index+1) * layer_size(index);
+    }
+    genome_length = gene;
+
+    genomes.assign(genome_length * capacity, 0);
+    activations.assign(row * capacity, 0);
+}
+
+void BatchedNetwork::forward_propagation(unsigned begin, unsigned end) {
+    unsigned count = end - begin;
+    for (unsigned index = 1; index < num_layers; ++index) {
+        unsigned rows = layer_size(index);
+        float* out = activations.data() + activation_offsets[index] * capacity + begin;
+        Matrix::batched_multiply_into(genomes.data() + weight_offsets[index-1] * capacity + begin,
+                                      activations.data() + activation_offsets[index-1] * capacity + begin,
+                                      out, rows, layer_size(index-1), count, capacity);
+
+        const float* bias = genomes.data() + bias_offsets[index] * capacity + begin;
+        for (unsigned i = 0; i < rows; ++i) {
+            Matrix::bias_ReLU(out + i * capacity, bias + i * capacity, count);
+        }
+    }
+}
@@ -0,0 +1,78 @@
+#ifndef __BATCHED_NETWORK_HPP__
+#define __BATCHED_NETWORK_HPP__
+
+#include "Matrix.h"
+#include "NeuralNetwork.hpp"
+
+#include <vector>
+
+using namespace std;
+
+// Evaluates a whole population of networks that share one topology in a single pass.
+//
+// Every gene, input and activation is stored population major: gene g of member p
+// lives at genomes[g * capacity + p]. A layer of the whole population then becomes
+// a handful of loops over contiguous memory instead of one small matvec per network.
+class BatchedNetwork {
+private:
+    NetworkParams params;
+    unsigned num_layers;
+    unsigned capacity;
+    unsigned genome_length;
+
+    vector<float> genomes;     //genome_length * capacity, same gene order as NeuralNetwork::get_genome
+    vector<float> activations; //sum of layer sizes * capacity
+
+    vector<unsigned> bias_offsets;       //first gene of each layer's biases
+    vector<unsigned> weight_offsets;     //first gene of each adjacency matrix
+    vector<unsigned> activation_offsets; //first row of each layer's activations
+
+public:
+    BatchedNetwork(NetworkParams & params, unsigned capacity);
+
+    //copies nn's genome into member slot, nn has to have the same topology
+    void load(unsigned slot, const NeuralNetwork* nn) {
+        const float* genome = nn->get_genome();
+        for (unsigned g = 0; g < genome_length; ++g) {
+            genomes[g * capacity + slot] = genome[g];
+        }
+    }
+
+    //inputs of the member in slot, read in the same order the Sensor writes them
+    void set_inputs(unsigned slot, const float* inputs) {
+        for (unsigned j = 0; j < params.inputs; ++j) {
+            activations[j * capacity + slot] = inputs[j];
+        }
+    }
+
+    //outputs of the member in slot, outputs has to hold params.outputs floats
+    void get_outputs(unsigned slot, float* outputs) const {
+        const float* last = activations.data() + activation_offsets[num_layers-1] * capacity;
+        for (unsigned k = 0; k < params.outputs; ++k) {
+            outputs[k] = last[k * capacity + slot];
+        }
+    }
+
+    void forward_propagation() {
+        forward_propagation(0, capacity);
+    }
+
+    //evaluates members [begin, end) only, disjoint ranges can run on different threads
+    void forward_propagation(unsigned begin, unsigned end);
+
+    unsigned size() {
+        return capacity;
+    }
+private:
+    unsigned layer_size(unsigned layer) const {
+        if (layer == 0) { //input layer
+            return params.inputs;
+        }
+        else if (layer == num_layers - 1) { //output layer
+            return params.outputs;
+        }
+        return params.hidden_layer_size; //hidden_layers
+    }
+};
+
+#endif
@@ -0,0 +1,166 @@
+#include "Checkpoint.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+vector<unsigned char> Checkpoint::serialize() const {
+    unsigned num_best = best_fitness.size();
+    size_t best_size = num_best * (4 + (size_t)genome_length * 4);
+    size_t networks_size = (size_t)generation_size * genome_length * 4;
+    vector<unsigned char> buffer(HEADER_SIZE + best_size + networks_size);
+
+    size_t offset = HEADER_SIZE;
+    for (unsigned i = 0; i < num_best; ++i) {
+        GenomeFile::put_floats(&buffer.at(offset), &best_fitness.at(i), 1);
+        GenomeFile::put_floats(&buffer.at(offset + 4), best_genomes.data() + (size_t)i * genome_length, genome_length);
+        offset += 4 + (size_t)genome_length * 4;
+    }
+    if (networks_size > 0) {
+        GenomeFile::put_floats(&buffer.at(offset), networks.data(), generation_size * genome_length);
+    }
+
+    uint32_t rate_bits;
+    memcpy(&rate_bits, &mutation_rate, 4);
+    const uint32_t fields[12] = {
+        VERSION, params.inputs, params.outputs, params.hidden_layers, params.hidden_layer_size,
+        rate_bits, generation_size, num_generations, seed, num_best, genome_length,
+        GenomeFile::checksum(buffer.data() + HEADER_SIZE, best_size + networks_size)
+    };
+    memcpy(buffer.data(), MAGIC, 4);
+    for (unsigned i = 0; i < 12; ++i) {
+        GenomeFile::put_u32(buffer.data() + 4 + i * 4, fields[i]);
+    }
+    return buffer;
+}
+
+bool Checkpoint::read(string path) {
+    ifstream fin(path, ios::binary | ios::ate);
+    if (!fin.is_open()) {
+        return false;
+    }
+    streamsize size = fin.tellg();
+    fin.seekg(0);
+    vector<unsigned char> buffer(size > 0 ? size : 0);
+    fin.read((char*)buffer.data(), buffer.size());
+
+    if (buffer.size() < HEADER_SIZE || memcmp(buffer.data(), MAGIC, 4) != 0) {
+        throw("not a checkpoint file\n");
+    }
+    uint32_t fields[12];
+    for (unsigned i = 0; i < 12; ++i) {
+        fields[i] = GenomeFile::get_u32(buffer.data() + 4 + i * 4);
+    }
+    if (fields[0] != VERSION) {
+        throw("unsupported checkpoint version\n");
+    }
+    params = NetworkParams(fields[1], fields[2], fields[3], fields[4]);
+    memcpy(&mutation_rate, &fields[5], 4);
+    generation_size = fields[6];
+    num_generations = fields[7];
+    seed = fields[8];
+    unsigned num_best = fields[9];
+    genome_length = fields[10];
+    //checked before the sizes below are trusted, the header isn't covered by the checksum
+    if (genome_length == 0 || genome_length != NeuralNetwork::genome_length_of(fields[1], fields[2], fields[3], fields[4])) {
+        throw("the checkpoint file does not match its topology\n");
+    }
+
+    size_t best_size = num_best * (4 + (size_t)genome_length * 4);
+    size_t networks_size = (size_t)generation_size * genome_length * 4;
+    if (buffer.size() != HEADER_SIZE + best_size + networks_size) {
+        throw("the checkpoint file is truncated\n");
+    }
+    if (GenomeFile::checksum(buffer.data() + HEADER_SIZE, best_size + networks_size) != fields[11]) {
+        throw("the checkpoint file is corrupted\n");
+    }
+
+    best_fitness.resize(num_best);
+    best_genomes.resize((size_t)num_best * genome_length);
+    size_t offset = HEADER_SIZE;
+    for (unsigned i = 0; i < num_best; ++i) {
+        GenomeFile::get_floats(&buffer.at(offset), &best_fitness.at(i), 1);
+        GenomeFile::get_floats(&buffer.at(offset + 4), best_genomes.data() + (size_t)i * genome_length, genome_length);
+        offset += 4 + (size_t)genome_length * 4;
+    }
+    networks.resize((size_t)generation_size * genome_length);
+    if (networks_size > 0) {
+        GenomeFile::get_floats(&buffer.at(offset), networks.data(), generation_size * genome_length);
+    }
+    return true;
+}
+
+CheckpointWriter::CheckpointWriter(): stopping(false), pending(false), writing(false) {
+    worker = thread(&CheckpointWriter::worker_loop, this);
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    signal.notify_all();
+    worker.join(); //pending checkpoints are still written
+}
+
+void CheckpointWriter::write(string path, Checkpoint && checkpoint) {
+    {
+        lock_guard<mutex> guard(lock);
+        this->path = path;
+        this->checkpoint = move(checkpoint);
+        pending = true;
+    }
+    signal.notify_all();
+}
+
+void CheckpointWriter::wait() {
+    unique_lock<mutex> guard(lock);
+    signal.wait(guard, [this] { return !pending && !writing; });
+}
+
+bool CheckpointWriter::write_atomic(string path, const vector<unsigned char> & buffer) {
+    string temp_path = path + ".tmp";
+    {
+        ofstream fout(temp_path, ios::binary | ios::trunc);
+        if (!fout.is_open()) {
+            cout << "could not open file: " << temp_path << endl;
+            return false;
+        }
+        fout.write((const char*)buffer.data(), buffer.size());
+        fout.flush();
+        if (!fout.good()) {
+            cout << "could not write checkpoint: " << temp_path << endl;
+            return false;
+        }
+    }
+    error_code error;
+    filesystem::rename(temp_path, path, error);
+    if (error) {
+        cout << "could not replace checkpoint: " << path << endl;
+        return false;
+    }
+    return true;
+}
+
+void CheckpointWriter::worker_loop() {
+    unique_lock<mutex> guard(lock);
+    while (true) {
+        signal.wait(guard, [this] { return stopping || pending; });
+        if (!pending) { //stopping with nothing left to write
+            return;
+        }
+        string path = this->path;
+        Checkpoint checkpoint = move(this->checkpoint);
+        pending = false;
+        writing = true;
+        guard.unlock();
+
+        write_atomic(path, checkpoint.serialize());
+
+        guard.lock();
+        writing = false;
+        signal.notify_all();
+    }
+}
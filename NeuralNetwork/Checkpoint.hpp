@@ -0,0 +1,86 @@
+#ifndef __CHECKPOINT_HPP__
+#define __CHECKPOINT_HPP__
+
+#include "NeuralNetwork.hpp"
+#include "GenomeFile.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Everything a NetworkHandler needs to pick a training run back up at the start
+// of a generation, and its binary file:
+//
+//   header   magic "PNGC", version, inputs, outputs, hidden_layers, hidden_layer_size,
+//            mutation_rate, generation_size, num_generations, seed, num_best,
+//            genome_length, checksum                            (13 x 4 bytes)
+//   best     num_best x [ fitness | genome_length genes ]
+//   networks generation_size x [ genome_length genes ]
+//
+// Same conventions as GenomeFile: little endian, FNV-1a checksum over everything
+// after the header.
+class Checkpoint {
+public:
+    static constexpr const char* MAGIC = "PNGC";
+    static const uint32_t VERSION = 1;
+    static const unsigned HEADER_SIZE = 13 * 4;
+
+    NetworkParams params;
+    float mutation_rate;
+    unsigned generation_size;
+    unsigned num_generations;
+    unsigned seed;
+    unsigned genome_length;
+
+    vector<float> networks;     //generation_size genomes back to back
+    vector<float> best_genomes; //best_fitness.size() genomes back to back
+    vector<float> best_fitness;
+
+    Checkpoint(): mutation_rate(0), generation_size(0), num_generations(0), seed(0), genome_length(0) {}
+
+    vector<unsigned char> serialize() const;
+
+    //false if the file can't be opened, throws if it is not a valid checkpoint
+    bool read(string path);
+};
+
+// Writes checkpoints on a background thread so the simulation never waits on the disk.
+//
+// Each file is written next to its destination and renamed over it, so a crash
+// mid write leaves the previous checkpoint intact. If a new checkpoint is submitted
+// before the last one was written, only the newest is kept.
+class CheckpointWriter {
+private:
+    thread worker;
+    mutex lock;
+    condition_variable signal;
+
+    bool stopping;
+    bool pending;
+    bool writing;
+    string path;
+    Checkpoint checkpoint;
+
+public:
+    CheckpointWriter();
+
+    ~CheckpointWriter();
+
+    void write(string path, Checkpoint && checkpoint);
+
+    //blocks until every submitted checkpoint is on disk
+    void wait();
+
+    static bool write_atomic(string path, const vector<unsigned char> & buffer);
+
+private:
+    void worker_loop();
+};
+
+#endif
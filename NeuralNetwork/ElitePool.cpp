@@ -0,0 +1,98 @@
+#include "ElitePool.hpp"
+
+#include <algorithm>
+
+using namespace std;
+
+NeuralNetwork* ElitePool::offer(NeuralNetwork* network, float fitness) {
+    uint64_t hash = network->hash();
+
+    unordered_map<uint64_t, unsigned>::iterator found = positions.find(hash);
+    if (found != positions.end()) {
+        unsigned i = found->second;
+        if (fitness > heap[i].fitness) {
+            heap[i].fitness = fitness;
+            sift_down(i);
+        }
+        return network;
+    }
+
+    if (heap.size() < capacity) {
+        heap.push_back({network, fitness, hash});
+        positions[hash] = heap.size() - 1;
+        sift_up(heap.size() - 1);
+        return nullptr;
+    }
+    if (heap.empty() || fitness < heap[0].fitness) {
+        return network;
+    }
+
+    //replaces the weakest member
+    NeuralNetwork* evicted = heap[0].network;
+    positions.erase(heap[0].hash);
+    heap[0] = {network, fitness, hash};
+    positions[hash] = 0;
+    sift_down(0);
+    return evicted;
+}
+
+void ElitePool::decay(float amount) {
+    for (unsigned i = 0; i < heap.size(); ++i) {
+        heap[i].fitness -= amount;
+    }
+}
+
+void ElitePool::clear() {
+    for (unsigned i = 0; i < heap.size(); ++i) {
+        delete heap[i].network;
+    }
+    heap.clear();
+    positions.clear();
+}
+
+vector<pair<NeuralNetwork*, float>> ElitePool::sorted() const {
+    vector<pair<NeuralNetwork*, float>> members;
+    for (unsigned i = 0; i < heap.size(); ++i) {
+        members.push_back(make_pair(heap[i].network, heap[i].fitness));
+    }
+    sort(members.begin(), members.end(), [](const pair<NeuralNetwork*, float> & a, const pair<NeuralNetwork*, float> & b) {
+        return a.second > b.second;
+    });
+    return members;
+}
+
+void ElitePool::sift_up(unsigned i) {
+    while (i > 0) {
+        unsigned parent = (i - 1) / 2;
+        if (heap[parent].fitness <= heap[i].fitness) {
+            break;
+        }
+        swap_entries(i, parent);
+        i = parent;
+    }
+}
+
+void ElitePool::sift_down(unsigned i) {
+    while (true) {
+        unsigned smallest = i;
+        unsigned left = 2 * i + 1;
+        unsigned right = left + 1;
+        if (left < heap.size() && heap[left].fitness < heap[smallest].fitness) {
+            smallest = left;
+        }
+        if (right < heap.size() && heap[right].fitness < heap[smallest].fitness) {
+            smallest = right;
+        }
+        if (smallest == i) {
+            break;
+        }
+        swap_entries(i, smallest);
+        i = smallest;
+    }
+}
+
+void ElitePool::swap_entries(unsigned a, unsigned b) {
+    swap(heap[a], heap[b]);
+    positions[heap[a].hash] = a;
+    positions[heap[b].hash] = b;
+}
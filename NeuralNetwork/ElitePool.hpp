@@ -0,0 +1,81 @@
+#ifndef __ELITE_POOL_HPP__
+#define __ELITE_POOL_HPP__
+
+#include "NeuralNetwork.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// The fittest networks seen so far, at most capacity of them.
+//
+// Kept as a min-heap on fitness so the weakest member is always at the root and a
+// new network is let in or turned away in O(log capacity). Members are found by a
+// hash of their genome, so a network that is already in the pool (the elites are
+// copied into every new generation) only has its fitness raised instead of being
+// compared gene by gene against every member. Those copies share the member's genome
+// block, whose hash is kept with it, so they aren't even hashed again.
+//
+// The pool owns its networks: offer() takes the pointer it is given and hands back
+// whichever network did not make it, so the caller can reuse it (see NetworkPool).
+class ElitePool {
+private:
+    struct Entry {
+        NeuralNetwork* network;
+        float fitness;
+        uint64_t hash;
+    };
+
+    unsigned capacity;
+    vector<Entry> heap;
+    unordered_map<uint64_t, unsigned> positions; //genome hash -> index into heap
+
+public:
+    ElitePool(unsigned capacity): capacity(capacity) {
+        heap.reserve(capacity);
+        positions.reserve(capacity);
+    }
+
+    ~ElitePool() {
+        clear();
+    }
+
+    ElitePool(const ElitePool &) = delete;
+    ElitePool & operator=(const ElitePool &) = delete;
+
+    //returns the network that left: network itself if it wasn't kept, the evicted member,
+    //or nullptr if the pool just grew. the caller owns what is returned
+    NeuralNetwork* offer(NeuralNetwork* network, float fitness);
+
+    //lowers every fitness by amount, the heap order stays the same
+    void decay(float amount);
+
+    void clear();
+
+    //members in heap order, index 0 is the weakest
+    unsigned size() const {
+        return heap.size();
+    }
+    NeuralNetwork* network(unsigned i) const {
+        return heap.at(i).network;
+    }
+    float fitness(unsigned i) const {
+        return heap.at(i).fitness;
+    }
+
+    //pair<network, fitness> for every member, fittest first
+    vector<pair<NeuralNetwork*, float>> sorted() const;
+
+private:
+    void sift_up(unsigned i);
+
+    void sift_down(unsigned i);
+
+    void swap_entries(unsigned a, unsigned b);
+};
+
+#endif
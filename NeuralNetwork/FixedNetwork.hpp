@@ -0,0 +1,150 @@
+#ifndef __FIXED_NETWORK_HPP__
+#define __FIXED_NETWORK_HPP__
+
+#include "Matrix.h"
+#include "NeuralNetwork.hpp"
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <utility>
+
+using namespace std;
+
+// A NeuralNetwork whose topology is known at compile time.
+//
+// The genome uses exactly the same layout as NeuralNetwork::get_genome (biases of
+// every layer, then the weights of every adjacency matrix row major), so networks
+// convert with a memcpy and load/save the same files. Every layer size and offset
+// is a constant, so the forward pass is unrolled by the compiler and has no
+// per-layer branching or heap storage.
+template<unsigned In, unsigned Out, unsigned Hidden, unsigned Width>
+class FixedNetwork {
+    static_assert(Hidden >= 1, "at least 1 hidden layer is required");
+public:
+    static const unsigned NUM_BIASES = In + Hidden * Width + Out;
+    static const unsigned GENOME_SIZE = NUM_BIASES + Width * In + (Hidden - 1) * Width * Width + Out * Width;
+
+private:
+    array<float, GENOME_SIZE> genome;
+    array<float, In> inputs;
+    array<float, Out> outputs;
+
+public:
+    FixedNetwork() {
+        genome.fill(0);
+        inputs.fill(0);
+        outputs.fill(0);
+    }
+
+    //nn has to have the same topology, see matches()
+    explicit FixedNetwork(const NeuralNetwork & nn): FixedNetwork() {
+        if (nn.genome_size() != GENOME_SIZE) {
+            throw("the neural network does not have the topology of this FixedNetwork\n");
+        }
+        memcpy(genome.data(), nn.get_genome(), sizeof(genome));
+    }
+
+    //reads the same save files as NeuralNetwork
+    explicit FixedNetwork(string directory): FixedNetwork() {
+        NeuralNetwork nn(directory);
+        if (!matches(nn.get_params())) {
+            throw("the saved network does not have the topology of this FixedNetwork\n");
+        }
+        memcpy(genome.data(), nn.get_genome(), sizeof(genome));
+    }
+
+    string save(string directory, unsigned fitness) const {
+        NetworkParams params = get_params();
+        NeuralNetwork nn(params);
+        nn.set_genome(genome.data());
+        return nn.save(directory, fitness);
+    }
+
+    static bool matches(NetworkParams params) {
+        return params.inputs == In && params.outputs == Out && params.hidden_layers == Hidden && params.hidden_layer_size == Width;
+    }
+
+    static NetworkParams get_params() {
+        return NetworkParams(In, Out, Hidden, Width);
+    }
+
+    float* get_inputs() {
+        return inputs.data();
+    }
+    const float* get_outputs() const {
+        return outputs.data();
+    }
+    float* get_genome() {
+        return genome.data();
+    }
+    const float* get_genome() const {
+        return genome.data();
+    }
+
+    void forward_propagation() {
+        forward(genome.data(), inputs.data(), outputs.data());
+    }
+
+    //runs a genome with this topology that is stored elsewhere, e.g. in a NeuralNetwork
+    static void forward(const float* genome, const float* in, float* out) {
+        float first[Width];
+        float second[Width];
+
+        layer<Width, In>(genome + weight_offset(0), genome + bias_offset(1), in, first);
+
+        float* current = first;
+        float* next = second;
+        for (unsigned index = 1; index < Hidden; ++index) { //hidden layer -> hidden layer, gone when Hidden == 1
+            layer<Width, Width>(genome + weight_offset(index), genome + bias_offset(index + 1), current, next);
+            swap(current, next);
+        }
+
+        layer<Out, Width>(genome + weight_offset(Hidden), genome + bias_offset(Hidden + 1), current, out);
+    }
+
+private:
+    //first bias of a layer, layer 0 being the input layer
+    static constexpr unsigned bias_offset(unsigned layer) {
+        return layer == 0 ? 0 : In + (layer - 1) * Width;
+    }
+
+    //first weight of the adjacency matrix between layer index and index + 1
+    static constexpr unsigned weight_offset(unsigned index) {
+        return index == 0 ? NUM_BIASES : NUM_BIASES + Width * In + (index - 1) * Width * Width;
+    }
+
+    template<unsigned Rows, unsigned Cols>
+    static void layer(const float* weights, const float* biases, const float* in, float* out) {
+        rows<Cols>(weights, biases, in, out, make_index_sequence<Rows>());
+    }
+
+    template<unsigned Cols, size_t... Row>
+    static void rows(const float* weights, const float* biases, const float* in, float* out, index_sequence<Row...>) {
+        ((out[Row] = Matrix::ReLU(dot(weights + Row * Cols, in, make_index_sequence<Cols>()) + biases[Row])), ...);
+    }
+
+    //same summation order as Matrix::multiply_into_scalar
+    template<size_t... Col>
+    static float dot(const float* row, const float* in, index_sequence<Col...>) {
+        float running_sum = 0;
+        ((running_sum += row[Col] * in[Col]), ...);
+        return running_sum;
+    }
+};
+
+// the two topologies every network in saves/ uses
+typedef FixedNetwork<3, 3, 1, 5> FixedNetwork3315;
+typedef FixedNetwork<4, 3, 1, 5> FixedNetwork4315;
+
+// forward pass of a genome stored elsewhere: (genome, inputs, outputs)
+typedef void (*FixedForward)(const float*, const float*, float*);
+
+// the unrolled forward pass for params, or nullptr when no FixedNetwork is compiled for it
+inline FixedForward fixed_forward_for(NetworkParams params) {
+    if (FixedNetwork3315::matches(params)) return &FixedNetwork3315::forward;
+    if (FixedNetwork4315::matches(params)) return &FixedNetwork4315::forward;
+    return nullptr;
+}
+
+#endif
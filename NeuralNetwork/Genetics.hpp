@@ -0,0 +1,128 @@
+#ifndef __GENETICS_HPP__
+#define __GENETICS_HPP__
+
+#include "Matrix.h"
+#include "Random.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+// Crossover and mutation over whole flat genomes.
+//
+// Uniform crossover draws one 64 bit word per 64 genes instead of one number per
+// gene: bit i of the word picks parent a (1) or parent b (0) for gene i, and the
+// vector kernels turn 4 or 8 bits at a time into a lane mask and blend. Mutation
+// doesn't roll for every gene either: the gap to the next mutated gene is
+// geometrically distributed, so it is drawn directly and only the genes that do
+// mutate cost a random number or two.
+//
+// Both give every gene the same odds as rolling for it on its own (a fair coin
+// for crossover, mutation_rate for mutation). The kernels are picked with
+// Matrix::simd_level() and give the same child bit for bit.
+class Genetics {
+public:
+    //child[i] = a[i] or b[i], each with probability 1/2. child may be a or b
+    static void crossover(const float* a, const float* b, float* child, unsigned length, Random & rng) {
+        if (a == b) { //nothing to choose between, and no random words drawn
+            if (child != a) {
+                memmove(child, a, length * sizeof(float));
+            }
+            return;
+        }
+        for (unsigned begin = 0; begin < length; begin += 64) {
+            unsigned count = length - begin < 64 ? length - begin : 64;
+            blend(a + begin, b + begin, child + begin, count, rng.next());
+        }
+    }
+
+    //adds uniform(-1, 1) to each gene with probability mutation_rate
+    static void mutate(float* genome, unsigned length, float mutation_rate, Random & rng) {
+        if (mutation_rate <= 0) {
+            return;
+        }
+        if (mutation_rate >= 1) {
+            for (unsigned i = 0; i < length; ++i) {
+                genome[i] += rng.uniform(-1, 1);
+            }
+            return;
+        }
+        //the number of genes skipped before the next mutation is geometric(mutation_rate):
+        //floor(log(u) / log(1 - mutation_rate)) for u uniform in (0, 1]
+        const double scale = 1.0 / log1p(-(double)mutation_rate);
+        double i = -1;
+        while (true) {
+            i += 1 + floor(log(1.0 - rng.uniform()) * scale);
+            if (i >= length) {
+                return;
+            }
+            genome[(unsigned)i] += rng.uniform(-1, 1);
+        }
+    }
+
+    //crossover of a and b into child, then mutation of child
+    static void breed(const float* a, const float* b, float* child, unsigned length, float mutation_rate, Random & rng) {
+        crossover(a, b, child, length, rng);
+        mutate(child, length, mutation_rate, rng);
+    }
+
+    //child[i] = bit i of mask ? a[i] : b[i] for i < count <= 64
+    static void blend(const float* a, const float* b, float* child, unsigned count, uint64_t mask) {
+#ifdef MATRIX_X86_SIMD
+        if (Matrix::simd_level() == Matrix::AVX2) {
+            blend_avx2(a, b, child, count, mask);
+            return;
+        }
+        if (Matrix::simd_level() == Matrix::SSE2) {
+            blend_sse2(a, b, child, count, mask);
+            return;
+        }
+#endif
+        blend_scalar(a, b, child, count, mask);
+    }
+
+    //
+    // scalar reference kernel
+    //
+    static void blend_scalar(const float* a, const float* b, float* child, unsigned count, uint64_t mask) {
+        for (unsigned i = 0; i < count; ++i) {
+            child[i] = (mask >> i) & 1 ? a[i] : b[i];
+        }
+    }
+
+#ifdef MATRIX_X86_SIMD
+    //
+    // SSE2 kernel, 4 genes per step
+    //
+    __attribute__((target("sse2")))
+    static void blend_sse2(const float* a, const float* b, float* child, unsigned count, uint64_t mask) {
+        const __m128i lanes = _mm_set_epi32(8, 4, 2, 1);
+        unsigned i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m128i bits = _mm_and_si128(_mm_set1_epi32((int)((mask >> i) & 0xF)), lanes);
+            __m128 select = _mm_castsi128_ps(_mm_cmpeq_epi32(bits, lanes));
+            __m128 x = _mm_and_ps(select, _mm_loadu_ps(a + i));
+            __m128 y = _mm_andnot_ps(select, _mm_loadu_ps(b + i));
+            _mm_storeu_ps(child + i, _mm_or_ps(x, y));
+        }
+        blend_scalar(a + i, b + i, child + i, count - i, mask >> (i & 63));
+    }
+
+    //
+    // AVX2 kernel, 8 genes per step
+    //
+    __attribute__((target("avx2")))
+    static void blend_avx2(const float* a, const float* b, float* child, unsigned count, uint64_t mask) {
+        const __m256i lanes = _mm256_set_epi32(128, 64, 32, 16, 8, 4, 2, 1);
+        unsigned i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m256i bits = _mm256_and_si256(_mm256_set1_epi32((int)((mask >> i) & 0xFF)), lanes);
+            __m256 select = _mm256_castsi256_ps(_mm256_cmpeq_epi32(bits, lanes));
+            _mm256_storeu_ps(child + i, _mm256_blendv_ps(_mm256_loadu_ps(b + i), _mm256_loadu_ps(a + i), select));
+        }
+        blend_sse2(a + i, b + i, child + i, count - i, mask >> (i & 63));
+    }
+#endif
+};
+
+#endif
@@ -0,0 +1,97 @@
+#ifndef __GENOME_BLOCK_HPP__
+#define __GENOME_BLOCK_HPP__
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <new>
+
+using namespace std;
+
+// The biases and weights of a network, shared by every network that carries them.
+//
+// A block is never written while more than one network refers to it. An elite
+// copied into the next generation, or a network the ElitePool keeps, only takes
+// another reference; a network gets a block of its own again once it is bred,
+// randomized or given other genes (see NeuralNetwork::unshare). Since a shared
+// block can't change, its hash is worked out once and kept with it.
+//
+// References are counted atomically, children are bred on several threads at once.
+class GenomeBlock {
+private:
+    atomic<unsigned> references;
+    mutable atomic<uint64_t> cached_hash; //0 until hash() is first called
+    unsigned length;
+    float* genes;
+
+    GenomeBlock(unsigned length): references(1), cached_hash(0), length(length) {
+        genes = static_cast<float*>(operator new[](length * sizeof(float), align_val_t(ALIGNMENT)));
+        memset(genes, 0, length * sizeof(float));
+    }
+
+    ~GenomeBlock() {
+        operator delete[](genes, align_val_t(ALIGNMENT));
+    }
+
+public:
+    static const unsigned ALIGNMENT = 64; //bytes, one cache line
+
+    //a block of length genes, all 0, with one reference
+    static GenomeBlock* create(unsigned length) {
+        return new GenomeBlock(length);
+    }
+
+    GenomeBlock(const GenomeBlock &) = delete;
+    GenomeBlock & operator=(const GenomeBlock &) = delete;
+
+    //one more reference to the same genes
+    GenomeBlock* acquire() {
+        references.fetch_add(1, memory_order_relaxed);
+        return this;
+    }
+
+    //drops a reference, the last one frees the block
+    void release() {
+        if (references.fetch_sub(1, memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    bool shared() const {
+        return references.load(memory_order_acquire) > 1;
+    }
+    unsigned use_count() const {
+        return references.load(memory_order_acquire);
+    }
+
+    const float* data() const {
+        return genes;
+    }
+    //only for the block's single owner, the cached hash is dropped
+    float* writable_data() {
+        cached_hash.store(0, memory_order_relaxed);
+        return genes;
+    }
+    unsigned size() const {
+        return length;
+    }
+
+    //FNV-1a over the gene bits, equal genes always hash the same
+    uint64_t hash() const {
+        uint64_t hash = cached_hash.load(memory_order_relaxed);
+        if (hash != 0) {
+            return hash;
+        }
+        hash = 14695981039346656037ull;
+        for (unsigned i = 0; i < length; ++i) {
+            uint32_t bits;
+            memcpy(&bits, genes + i, 4);
+            hash ^= bits;
+            hash *= 1099511628211ull;
+        }
+        cached_hash.store(hash, memory_order_relaxed);
+        return hash;
+    }
+};
+
+#endif
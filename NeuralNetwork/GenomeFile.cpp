@@ -0,0 +1,105 @@
+#include "GenomeFile.hpp"
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+bool GenomeFile::is_binary(string path) {
+    ifstream fin(path, ios::binary);
+    char magic[4] = {0, 0, 0, 0};
+    fin.read(magic, 4);
+    return fin.gcount() == 4 && memcmp(magic, MAGIC, 4) == 0;
+}
+
+bool GenomeFile::write(string path, Header header, const vector<const float*> & genomes, const vector<float> & fitness) {
+    header.version = VERSION;
+    header.count = genomes.size();
+
+    size_t record_size = 4 + (size_t)header.genome_length * 4;
+    vector<unsigned char> buffer(HEADER_SIZE + header.count * record_size);
+    size_t offset = HEADER_SIZE;
+    for (unsigned i = 0; i < header.count; ++i) {
+        put_floats(&buffer.at(offset), &fitness.at(i), 1);
+        put_floats(&buffer.at(offset + 4), genomes.at(i), header.genome_length);
+        offset += record_size;
+    }
+    header.checksum = checksum(buffer.data() + HEADER_SIZE, header.count * record_size);
+
+    unsigned char* out = buffer.data();
+    memcpy(out, MAGIC, 4);
+    const uint32_t fields[9] = {
+        header.version, header.inputs, header.outputs, header.hidden_layers, header.hidden_layer_size,
+        header.generation, header.count, header.genome_length, header.checksum
+    };
+    for (unsigned i = 0; i < 9; ++i) {
+        put_u32(out + 4 + i * 4, fields[i]);
+    }
+
+    ofstream fout(path, ios::binary | ios::trunc);
+    if (!fout.is_open()) {
+        cout << "could not open file: " << path << endl;
+        return false;
+    }
+    fout.write((const char*)buffer.data(), buffer.size());
+    return fout.good();
+}
+
+bool GenomeFile::read(string path, Header & header, vector<float> & genomes, vector<float> & fitness) {
+    ifstream fin(path, ios::binary | ios::ate);
+    if (!fin.is_open()) {
+        cout << "could not open file: " << path << endl;
+        return false;
+    }
+    streamsize size = fin.tellg();
+    fin.seekg(0);
+    vector<unsigned char> buffer(size > 0 ? size : 0);
+    fin.read((char*)buffer.data(), buffer.size());
+
+    if (buffer.size() < HEADER_SIZE || memcmp(buffer.data(), MAGIC, 4) != 0) {
+        throw("not a binary genome file\n");
+    }
+    uint32_t fields[9];
+    for (unsigned i = 0; i < 9; ++i) {
+        fields[i] = get_u32(buffer.data() + 4 + i * 4);
+    }
+    header.version = fields[0];
+    header.inputs = fields[1];
+    header.outputs = fields[2];
+    header.hidden_layers = fields[3];
+    header.hidden_layer_size = fields[4];
+    header.generation = fields[5];
+    header.count = fields[6];
+    header.genome_length = fields[7];
+    header.checksum = fields[8];
+
+    if (header.version != VERSION) {
+        throw("unsupported genome file version\n");
+    }
+    unsigned long long record_size = 4 + (unsigned long long)header.genome_length * 4;
+    if (buffer.size() - HEADER_SIZE != header.count * record_size) {
+        throw("the genome file is truncated\n");
+    }
+    const unsigned char* records = buffer.data() + HEADER_SIZE;
+    if (checksum(records, header.count * record_size) != header.checksum) {
+        throw("the genome file is corrupted\n");
+    }
+
+    genomes.resize((size_t)header.count * header.genome_length);
+    fitness.resize(header.count);
+    for (unsigned i = 0; i < header.count; ++i) {
+        const unsigned char* record = records + i * record_size;
+        get_floats(record, &fitness.at(i), 1);
+        get_floats(record + 4, genomes.data() + (size_t)i * header.genome_length, header.genome_length);
+    }
+    return true;
+}
+
+uint32_t GenomeFile::checksum(const unsigned char* bytes, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
@@ -0,0 +1,85 @@
+#ifndef __GENOME_FILE_HPP__
+#define __GENOME_FILE_HPP__
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Binary save format for one network or a whole population.
+//
+//   header   magic "PNGN", version, inputs, outputs, hidden_layers, hidden_layer_size,
+//            generation, count, genome_length, checksum        (10 x 4 bytes)
+//   records  count x [ fitness | genome_length genes ]          (floats)
+//
+// Every field is a 4 byte little endian value, the genes use the same order as
+// NeuralNetwork::get_genome. The checksum is FNV-1a over the record bytes.
+// A file is written and read with one buffered stream operation.
+class GenomeFile {
+public:
+    static constexpr const char* MAGIC = "PNGN";
+    static const uint32_t VERSION = 1;
+    static const unsigned HEADER_SIZE = 10 * 4;
+
+    struct Header {
+        uint32_t version;
+        uint32_t inputs;
+        uint32_t outputs;
+        uint32_t hidden_layers;
+        uint32_t hidden_layer_size;
+        uint32_t generation;
+        uint32_t count;
+        uint32_t genome_length;
+        uint32_t checksum;
+    };
+
+    //true if the file starts with the binary magic, text saves never do
+    static bool is_binary(string path);
+
+    //genomes[i] holds header.genome_length genes and scores fitness[i]
+    static bool write(string path, Header header, const vector<const float*> & genomes, const vector<float> & fitness);
+
+    //genomes gets count * genome_length genes back to back, fitness one value per record
+    static bool read(string path, Header & header, vector<float> & genomes, vector<float> & fitness);
+
+    //byte helpers shared with the other binary files
+    static uint32_t checksum(const unsigned char* bytes, size_t size);
+
+    static void put_u32(unsigned char* out, uint32_t x) {
+        out[0] = x;
+        out[1] = x >> 8;
+        out[2] = x >> 16;
+        out[3] = x >> 24;
+    }
+
+    static uint32_t get_u32(const unsigned char* in) {
+        return in[0] | (in[1] << 8) | (in[2] << 16) | ((uint32_t)in[3] << 24);
+    }
+
+    static void put_floats(unsigned char* out, const float* floats, unsigned count) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        memcpy(out, floats, count * 4);
+#else
+        for (unsigned i = 0; i < count; ++i) {
+            uint32_t bits;
+            memcpy(&bits, floats + i, 4);
+            put_u32(out + i * 4, bits);
+        }
+#endif
+    }
+
+    static void get_floats(const unsigned char* in, float* floats, unsigned count) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+        memcpy(floats, in, count * 4);
+#else
+        for (unsigned i = 0; i < count; ++i) {
+            uint32_t bits = get_u32(in + i * 4);
+            memcpy(floats + i, &bits, 4);
+        }
+#endif
+    }
+};
+
+#endif
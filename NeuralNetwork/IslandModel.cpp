@@ -0,0 +1,125 @@
+#include "IslandModel.hpp"
+#include "Random.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+
+static unsigned cores() {
+    unsigned count = thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+IslandModel::IslandModel(const Config & config):
+config(config), pool(min(config.islands, cores())), num_generations(0), checkpoint_interval(0) {
+    if (config.islands == 0 || config.population < config.islands) {
+        throw("the population is smaller than the number of islands\n");
+    }
+    unsigned num_islands = config.islands;
+    for (unsigned i = 0; i < num_islands; ++i) {
+        Config island = config;
+        island.population = config.population / num_islands + (i < config.population % num_islands);
+        island.seed = i == 0 ? config.seed : (unsigned)Random::mix(config.seed, i); //island 0 is the single population run
+        if (config.threads == 0) { //the islands share the cores instead of each starting a thread per core
+            island.threads = max(1u, cores() / num_islands);
+        }
+        islands.push_back(new NetworkHandler(island));
+        islands.back()->set_quiet(num_islands > 1);
+    }
+}
+
+IslandModel::~IslandModel() {
+    for (unsigned i = 0; i < islands.size(); ++i) {
+        delete islands.at(i); //waits for the island's last checkpoint
+    }
+}
+
+void IslandModel::init_networks() {
+    for (unsigned i = 0; i < islands.size(); ++i) {
+        islands.at(i)->init_networks();
+    }
+    num_generations = islands.at(0)->get_nth_generation();
+}
+
+bool IslandModel::resume(string path) {
+    unsigned resumed = 0;
+    for (unsigned i = 0; i < islands.size(); ++i) {
+        resumed += islands.at(i)->resume(checkpoint_path_of(path, i));
+    }
+    if (resumed != 0 && resumed != islands.size()) {
+        throw("only some islands have a checkpoint\n");
+    }
+    if (resumed != 0) { //every island was checkpointed in the same generation of the model
+        num_generations = islands.at(0)->get_nth_generation();
+    }
+    return resumed != 0;
+}
+
+void IslandModel::checkpoint(string path) {
+    for (unsigned i = 0; i < islands.size(); ++i) {
+        islands.at(i)->checkpoint(checkpoint_path_of(path, i));
+    }
+}
+
+void IslandModel::serve() {
+    for (unsigned i = 0; i < islands.size(); ++i) {
+        islands.at(i)->serve();
+    }
+}
+
+vector<float> IslandModel::evaluate(int x, int y, int w, int h, unsigned long long max_frames) {
+    vector<float> fittest(islands.size(), 0);
+    pool.parallel_for(islands.size(), 1, [&](unsigned begin, unsigned end) {
+        for (unsigned i = begin; i < end; ++i) {
+            vector<float> fitness = islands.at(i)->evaluate(x, y, w, h, max_frames);
+            fittest[i] = *max_element(fitness.begin(), fitness.end());
+        }
+    });
+
+    unsigned generation = ++num_generations;
+    if (islands.size() > 1) {
+        if (config.migration_interval != 0 && generation % config.migration_interval == 0) {
+            migrate();
+        }
+        cout << "generation #" << generation << ", most fit per island:";
+        for (unsigned i = 0; i < fittest.size(); ++i) {
+            cout << ' ' << fittest[i];
+        }
+        cout << endl;
+    }
+    if (checkpoint_interval != 0 && generation % checkpoint_interval == 0) {
+        checkpoint(checkpoint_path);
+    }
+    return fittest;
+}
+
+void IslandModel::migrate() {
+    //every island picks its emigrants before any island takes some in
+    vector<vector<float>> genomes(islands.size());
+    vector<float> fitness;
+    for (unsigned i = 0; i < islands.size(); ++i) {
+        islands.at(i)->emigrants(config.migrants, genomes.at(i), fitness);
+    }
+    for (unsigned i = 0; i < islands.size(); ++i) {
+        islands.at((i + 1) % islands.size())->immigrate(genomes.at(i));
+    }
+}
+
+void IslandModel::save(unsigned num_saves) {
+    vector<float> genomes;
+    vector<float> fitness;
+    for (unsigned i = 1; i < islands.size(); ++i) {
+        islands.at(i)->emigrants(num_saves, genomes, fitness);
+        islands.at(0)->keep(genomes, fitness);
+    }
+    islands.at(0)->save(num_saves);
+}
+
+string IslandModel::checkpoint_path_of(string path, unsigned i) {
+    if (islands.size() == 1) {
+        return path;
+    }
+    return path + ".island" + to_string(i);
+}
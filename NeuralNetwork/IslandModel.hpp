@@ -0,0 +1,87 @@
+#ifndef __ISLAND_MODEL_HPP__
+#define __ISLAND_MODEL_HPP__
+
+#include "NetworkHandler.hpp"
+#include "ThreadPool.hpp"
+#include "../config.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Evolves config.islands populations side by side instead of one big one.
+//
+// Every island is a NetworkHandler with its own share of the population, its own
+// kept networks and its own seed, and plays its generations on its own thread with
+// no locking at all. The islands only meet between generations: every
+// config.migration_interval generations each island sends copies of its
+// config.migrants fittest networks to the next island in a ring, where they replace
+// the last networks of the generation about to play. Islands drift apart in between,
+// which keeps the run more diverse than one population of the same size.
+//
+// Islands are for diversity, not speed: a single NetworkHandler already keeps every
+// core busy, so splitting its population into islands plays about as many
+// generations a second (the benchmark's islands rows stay within 20% of each other).
+//
+// A single island is exactly the NetworkHandler run it replaces, checkpoints included.
+class IslandModel {
+private:
+    Config config;
+    vector<NetworkHandler*> islands;
+    ThreadPool pool; //one thread per island, as far as there are cores
+    unsigned num_generations; //advanced once per evaluate(), steady state islands count their own generations
+
+    string checkpoint_path;
+    unsigned checkpoint_interval; //generations between checkpoints, 0 never writes one
+
+public:
+    //throws if config.population can't give every island a network
+    IslandModel(const Config & config);
+
+    ~IslandModel();
+
+    void init_networks();
+
+    //resumes every island from its checkpoint (see checkpoint_path_of()), returns false if there are none.
+    //throws if only some islands have one
+    bool resume(string path);
+
+    //checkpoints every island every interval generations, after the migration of that generation
+    void set_checkpoint(string path, unsigned interval) {
+        checkpoint_path = path;
+        checkpoint_interval = interval;
+    }
+
+    //snapshots every island into its own file, see checkpoint_path_of()
+    void checkpoint(string path);
+
+    void serve();
+
+    //plays one generation on every island at once and migrates if it is time to, returns the
+    //fittest network of each island. (x, y, w, h) is the left wall, see NetworkHandler::evaluate
+    vector<float> evaluate(int x, int y, int w, int h, unsigned long long max_frames = 0);
+
+    //each island's fittest networks replace the last networks of the next island's generation
+    void migrate();
+
+    //saves the num_saves fittest networks of all islands together.
+    //the other islands' networks are merged into the first island's kept networks to do so
+    void save(unsigned num_saves);
+
+    //the model's generation, which migrations and checkpoints go by
+    unsigned get_nth_generation() {
+        return num_generations;
+    }
+    unsigned size() {
+        return islands.size();
+    }
+    NetworkHandler & island(unsigned i) {
+        return *islands.at(i);
+    }
+
+    //the file island i is checkpointed to: path itself for a single island, path.island<i> otherwise
+    string checkpoint_path_of(string path, unsigned i);
+};
+
+#endif
@@ -1,8 +1,18 @@
 #ifndef __MATRIX_H__
 #define __MATRIX_H__
 
+// The SSE2/AVX2 kernels are compiled with per-function target attributes and picked
+// at runtime, so one binary runs on any x86 machine. Every other compiler or
+// architecture only gets the scalar kernels.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MATRIX_X86_SIMD
+#include <immintrin.h>
+#endif
+
 class Matrix {
 public:
+    enum SimdLevel { SCALAR = 0, SSE2 = 1, AVX2 = 2 };
+
     /*
     the cols of arr have to be the same as the rows of arr2
     ex
@@ -25,6 +35,73 @@ public:
         return return_arr;
     }
 
+    /*
+    same as multiply, but arr is stored row major in one block and the
+    result is written into solution, which must hold rows floats.
+    nothing is allocated, so this is safe to call every frame
+    */
+    static void multiply_into(const float* arr, const float* arr2, float* solution, unsigned rows, unsigned cols) {
+#ifdef MATRIX_X86_SIMD
+        if (simd_level() == AVX2) {
+            multiply_into_avx2(arr, arr2, solution, rows, cols);
+            return;
+        }
+        if (simd_level() == SSE2) {
+            multiply_into_sse2(arr, arr2, solution, rows, cols);
+            return;
+        }
+#endif
+        multiply_into_scalar(arr, arr2, solution, rows, cols);
+    }
+
+    /*
+    multiplies batch matrices by batch vectors at once. every element is stored
+    population major, so element k of member p is at [k * batch + p]:
+
+    arr      rows * cols * batch
+    arr2     cols * batch
+    solution rows * batch
+
+    the inner loop runs over the population, which keeps every access contiguous
+    */
+    static void batched_multiply_into(const float* arr, const float* arr2, float* solution, unsigned rows, unsigned cols, unsigned batch) {
+        batched_multiply_into(arr, arr2, solution, rows, cols, batch, batch);
+    }
+
+    /*
+    same as above for members [0, batch) of a population of stride members.
+    pass pointers offset by the first member to work on any slice of it
+    */
+    static void batched_multiply_into(const float* arr, const float* arr2, float* solution, unsigned rows, unsigned cols, unsigned batch, unsigned stride) {
+#ifdef MATRIX_X86_SIMD
+        if (simd_level() == AVX2) {
+            batched_multiply_into_avx2(arr, arr2, solution, rows, cols, batch, stride);
+            return;
+        }
+        if (simd_level() == SSE2) {
+            batched_multiply_into_sse2(arr, arr2, solution, rows, cols, batch, stride);
+            return;
+        }
+#endif
+        batched_multiply_into_scalar(arr, arr2, solution, rows, cols, batch, stride);
+    }
+
+    //arr[i] = ReLU(arr[i] + bias[i]) for the first size elements.
+    //the vector kernels give the same result bit for bit, -0 and NaN included
+    static void bias_ReLU(float* arr, const float* bias, unsigned size) {
+#ifdef MATRIX_X86_SIMD
+        if (simd_level() == AVX2) {
+            bias_ReLU_avx2(arr, bias, size);
+            return;
+        }
+        if (simd_level() == SSE2) {
+            bias_ReLU_sse2(arr, bias, size);
+            return;
+        }
+#endif
+        bias_ReLU_scalar(arr, bias, size);
+    }
+
     static float ReLU(float x) {
         if (x < 0) {
             return 0.0;
@@ -33,6 +110,190 @@ public:
             return x;
         }
     }
+
+    //best instruction set the cpu supports, detected once
+    static SimdLevel detected_simd_level() {
+#ifdef MATRIX_X86_SIMD
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) return AVX2;
+        if (__builtin_cpu_supports("sse2")) return SSE2;
+#endif
+        return SCALAR;
+    }
+
+    //kernels used by the dispatching functions above
+    static SimdLevel & simd_level() {
+        static SimdLevel level = detected_simd_level();
+        return level;
+    }
+
+    //lets tests and benchmarks force a kernel set, the level is clamped to what the cpu supports
+    static void set_simd_level(SimdLevel level) {
+        if (level > detected_simd_level()) {
+            level = detected_simd_level();
+        }
+        simd_level() = level;
+    }
+
+    //
+    // scalar reference kernels
+    //
+    static void multiply_into_scalar(const float* arr, const float* arr2, float* solution, unsigned rows, unsigned cols) {
+        for (unsigned i = 0; i < rows; ++i) {
+            const float* row = arr + i * cols;
+            float running_sum = 0;
+            for (unsigned j = 0; j < cols; ++j) {
+                running_sum += row[j] * arr2[j];
+            }
+            solution[i] = running_sum;
+        }
+    }
+
+    static void batched_multiply_into_scalar(const float* arr, const float* arr2, float* solution, unsigned rows, unsigned cols, unsigned batch, unsigned stride) {
+        for (unsigned i = 0; i < rows; ++i) {
+            float* out = solution + i * stride;
+            for (unsigned p = 0; p < batch; ++p) {
+                out[p] = 0;
+            }
+            for (unsigned j = 0; j < cols; ++j) {
+                const float* weight = arr + (i * cols + j) * stride;
+                const float* in = arr2 + j * stride;
+                for (unsigned p = 0; p < batch; ++p) {
+                    out[p] += weight[p] * in[p];
+                }
+            }
+        }
+    }
+
+    static void bias_ReLU_scalar(float* arr, const float* bias, unsigned size) {
+        for (unsigned i = 0; i < size; ++i) {
+            arr[i] = ReLU(arr[i] + bias[i]);
+        }
+    }
+
+#ifdef MATRIX_X86_SIMD
+    //
+    // SSE2 kernels
+    //
+    __attribute__((target("sse2")))
+    static void multiply_into_sse2(const float* arr, const float* arr2, float* solution, unsigned rows, unsigned cols) {
+        for (unsigned i = 0; i < rows; ++i) {
+            const float* row = arr + i * cols;
+            __m128 sum = _mm_setzero_ps();
+            unsigned j = 0;
+            for (; j + 4 <= cols; j += 4) {
+                sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(row + j), _mm_loadu_ps(arr2 + j)));
+            }
+            float lanes[4];
+            _mm_storeu_ps(lanes, sum);
+            float running_sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+            for (; j < cols; ++j) {
+                running_sum += row[j] * arr2[j];
+            }
+            solution[i] = running_sum;
+        }
+    }
+
+    __attribute__((target("sse2")))
+    static void batched_multiply_into_sse2(const float* arr, const float* arr2, float* solution, unsigned rows, unsigned cols, unsigned batch, unsigned stride) {
+        for (unsigned i = 0; i < rows; ++i) {
+            float* out = solution + i * stride;
+            unsigned p = 0;
+            for (; p + 4 <= batch; p += 4) {
+                __m128 sum = _mm_setzero_ps();
+                for (unsigned j = 0; j < cols; ++j) {
+                    __m128 weight = _mm_loadu_ps(arr + (i * cols + j) * stride + p);
+                    __m128 in = _mm_loadu_ps(arr2 + j * stride + p);
+                    sum = _mm_add_ps(sum, _mm_mul_ps(weight, in));
+                }
+                _mm_storeu_ps(out + p, sum);
+            }
+            for (; p < batch; ++p) {
+                float running_sum = 0;
+                for (unsigned j = 0; j < cols; ++j) {
+                    running_sum += arr[(i * cols + j) * stride + p] * arr2[j * stride + p];
+                }
+                out[p] = running_sum;
+            }
+        }
+    }
+
+    __attribute__((target("sse2")))
+    static void bias_ReLU_sse2(float* arr, const float* bias, unsigned size) {
+        const __m128 zero = _mm_setzero_ps();
+        unsigned i = 0;
+        for (; i + 4 <= size; i += 4) {
+            __m128 x = _mm_add_ps(_mm_loadu_ps(arr + i), _mm_loadu_ps(bias + i));
+            _mm_storeu_ps(arr + i, _mm_max_ps(zero, x));
+        }
+        for (; i < size; ++i) {
+            arr[i] = ReLU(arr[i] + bias[i]);
+        }
+    }
+
+    //
+    // AVX2 kernels
+    //
+    __attribute__((target("avx2")))
+    static void multiply_into_avx2(const float* arr, const float* arr2, float* solution, unsigned rows, unsigned cols) {
+        if (cols < 8) { //the 3-5 wide layers of our networks fit in one SSE register at most
+            multiply_into_sse2(arr, arr2, solution, rows, cols);
+            return;
+        }
+        for (unsigned i = 0; i < rows; ++i) {
+            const float* row = arr + i * cols;
+            __m256 sum = _mm256_setzero_ps();
+            unsigned j = 0;
+            for (; j + 8 <= cols; j += 8) {
+                sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(row + j), _mm256_loadu_ps(arr2 + j)));
+            }
+            float lanes[8];
+            _mm256_storeu_ps(lanes, sum);
+            float running_sum = ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) + ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7]));
+            for (; j < cols; ++j) {
+                running_sum += row[j] * arr2[j];
+            }
+            solution[i] = running_sum;
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static void batched_multiply_into_avx2(const float* arr, const float* arr2, float* solution, unsigned rows, unsigned cols, unsigned batch, unsigned stride) {
+        for (unsigned i = 0; i < rows; ++i) {
+            float* out = solution + i * stride;
+            unsigned p = 0;
+            for (; p + 8 <= batch; p += 8) {
+                __m256 sum = _mm256_setzero_ps();
+                for (unsigned j = 0; j < cols; ++j) {
+                    __m256 weight = _mm256_loadu_ps(arr + (i * cols + j) * stride + p);
+                    __m256 in = _mm256_loadu_ps(arr2 + j * stride + p);
+                    sum = _mm256_add_ps(sum, _mm256_mul_ps(weight, in));
+                }
+                _mm256_storeu_ps(out + p, sum);
+            }
+            for (; p < batch; ++p) {
+                float running_sum = 0;
+                for (unsigned j = 0; j < cols; ++j) {
+                    running_sum += arr[(i * cols + j) * stride + p] * arr2[j * stride + p];
+                }
+                out[p] = running_sum;
+            }
+        }
+    }
+
+    __attribute__((target("avx2")))
+    static void bias_ReLU_avx2(float* arr, const float* bias, unsigned size) {
+        const __m256 zero = _mm256_setzero_ps();
+        unsigned i = 0;
+        for (; i + 8 <= size; i += 8) {
+            __m256 x = _mm256_add_ps(_mm256_loadu_ps(arr + i), _mm256_loadu_ps(bias + i));
+            _mm256_storeu_ps(arr + i, _mm256_max_ps(zero, x));
+        }
+        for (; i < size; ++i) {
+            arr[i] = ReLU(arr[i] + bias[i]);
+        }
+    }
+#endif
 };
 
 #endif
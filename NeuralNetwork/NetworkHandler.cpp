@@ -0,0 +1,534 @@
+#include "NetworkHandler.hpp"
+#include "AI.hpp"
+#include "../console.hpp"
+
+#include <algorithm>
+#include <ctime>
+#include <filesystem>
+#include <utility>      // std::pair, std::make_pair
+
+using namespace std;
+
+static bool has(vector<unsigned> v, unsigned item) {
+    for (unsigned i = 0; i < v.size(); ++i) {
+        if (v.at(i) == item) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static Config handler_config(NetworkParams params, float mutation_rate, unsigned generation_size) {
+    Config config;
+    config.topology = params;
+    config.mutation_rate = mutation_rate;
+    config.population = generation_size;
+    return config;
+}
+
+//floats a chunk's scratch buffer takes, whole cache lines so chunks on different threads never write the same one
+static unsigned scratch_size(unsigned floats) {
+    const unsigned line = 64 / sizeof(float);
+    return (floats + line - 1) / line * line;
+}
+
+NetworkHandler::NetworkHandler(const Config & config):
+config(config), network_params(config.topology), mutation_rate(config.mutation_rate), generation_size(config.population),
+network_pool(network_params), best_networks(config.num_fittest), num_alive(generation_size), prev_alive(0),
+world(generation_size, (HEIGHT/config.height_ratio), 12, config.ball_speed, config.paddle_speed), died(generation_size), num_died((generation_size + CHUNK_SIZE - 1) / CHUNK_SIZE),
+chunk_inputs(num_died.size() * scratch_size(network_params.inputs)), chunk_outputs(num_died.size() * scratch_size(network_params.outputs)), networks(generation_size, nullptr), batch(nullptr), pool(config.threads), fittest(0), num_generations(0),
+seed(config.seed), steady_state(config.steady_state), births(0), last_fitness(generation_size, 0),
+decision_interval(config.decision_interval), actions(generation_size, DECIDE), frame(0), checkpoint_interval(0), quiet(false) {}
+
+NetworkHandler::NetworkHandler(unsigned inputs, unsigned outputs, unsigned hidden_layers, unsigned hidden_layer_size, float mutation_rate, unsigned generation_size):
+NetworkHandler(handler_config(NetworkParams(inputs, outputs, hidden_layers, hidden_layer_size), mutation_rate, generation_size)) {}
+
+NetworkHandler::~NetworkHandler() {
+    clear();
+    delete batch;
+}
+
+void NetworkHandler::init_networks() {
+    rng.seed(Random::mix(seed, num_generations));
+    batch = new BatchedNetwork(network_params, generation_size);
+    for (unsigned i = 0; i < generation_size; ++i) {
+        networks[i] = network_pool.acquire();
+        networks[i]->randomize(rng);
+        batch->load(i, networks[i]);
+    }
+    world.reset();
+
+    for (unsigned i = 0; i < config.num_rendered && i < generation_size; ++i) { //only render the first few players
+        rendered_indices.push_back(i);
+    }
+    ++num_generations;
+}
+
+void NetworkHandler::update() {
+    ++frame;
+    //each chunk of pairs is sensed, evaluated as one batch, moved and stepped on its own,
+    //so a pair is only ever touched by the thread that owns its chunk
+    pool.parallel_for(generation_size, CHUNK_SIZE, [this](unsigned begin, unsigned end) {
+        unsigned c = begin / CHUNK_SIZE;
+        float* inputs = chunk_inputs.data() + c * scratch_size(network_params.inputs);
+        float* outputs = chunk_outputs.data() + c * scratch_size(network_params.outputs);
+        num_died[c] = step_chunk(begin, end, frame, inputs, outputs);
+    });
+    //killed in index order on this thread, so which networks are kept doesn't depend on thread timing
+    for (unsigned c = 0; c < num_died.size(); ++c) {
+        for (unsigned k = 0; k < num_died[c]; ++k) {
+            kill(died[c * CHUNK_SIZE + k]);
+            if (steady_state) {
+                respawn(died[c * CHUNK_SIZE + k]);
+            }
+        }
+    }
+    if (steady_state) {
+        count_generations();
+    }
+    if (!quiet && clock() % 50 == 0 && num_alive != prev_alive) {
+        //system("CLS");
+        cout << "num alive: " << num_alive << endl;
+        prev_alive = num_alive;
+    }
+
+    if (num_alive == 0) {
+        end_generation();
+    }
+}
+
+vector<float> NetworkHandler::evaluate(int x, int y, int w, int h, unsigned long long max_frames) {
+    if (steady_state) {
+        return evaluate_steady(x, y, w, h, max_frames);
+    }
+    unsigned num_chunks = num_died.size();
+    vector<vector<pair<unsigned long long, unsigned>>> deaths(num_chunks); //per chunk, pair<frame, index>
+    unsigned long long start = frame;
+
+    pool.parallel_for(generation_size, CHUNK_SIZE, [&](unsigned begin, unsigned end) {
+        unsigned c = begin / CHUNK_SIZE;
+        float* inputs = chunk_inputs.data() + c * scratch_size(network_params.inputs);
+        float* outputs = chunk_outputs.data() + c * scratch_size(network_params.outputs);
+        vector<pair<unsigned long long, unsigned>> & chunk_deaths = deaths[c];
+        unsigned* chunk_died = died.data() + begin;
+
+        unsigned chunk_alive = 0;
+        for (unsigned i = begin; i < end; ++i) {
+            chunk_alive += world.alive[i];
+        }
+        unsigned long long chunk_frame = start;
+        while (chunk_alive > 0 && (max_frames == 0 || chunk_frame - start < max_frames)) {
+            Random chunk_rng(Random::mix(seed, num_generations, chunk_frame, begin)); //the stream bounce_off_wall uses
+            world.bounce_off_wall(x, y, w, h, begin, end, chunk_rng);
+            ++chunk_frame;
+
+            unsigned chunk_num_died = step_chunk(begin, end, chunk_frame, inputs, outputs);
+            for (unsigned k = 0; k < chunk_num_died; ++k) {
+                chunk_deaths.push_back(make_pair(chunk_frame, chunk_died[k]));
+            }
+            chunk_alive -= chunk_num_died;
+        }
+        for (unsigned i = begin; i < end; ++i) { //out of frames
+            if (world.alive[i]) {
+                world.alive[i] = 0;
+                chunk_deaths.push_back(make_pair(chunk_frame, i));
+            }
+        }
+    });
+
+    //killed in the order update() would have killed them, frame by frame then by index
+    vector<pair<unsigned long long, unsigned>> order;
+    for (unsigned c = 0; c < num_chunks; ++c) {
+        order.insert(order.end(), deaths[c].begin(), deaths[c].end());
+    }
+    sort(order.begin(), order.end());
+
+    vector<float> fitness(generation_size, 0);
+    for (unsigned k = 0; k < order.size(); ++k) {
+        fitness[order[k].second] = kill(order[k].second);
+    }
+    end_generation();
+    return fitness;
+}
+
+vector<float> NetworkHandler::evaluate_steady(int x, int y, int w, int h, unsigned long long max_frames) {
+    //chunks can't run ahead of each other here, every death changes the elite pool the next child is bred from
+    fill(last_fitness.begin(), last_fitness.end(), 0);
+    unsigned generation = num_generations;
+    unsigned long long frames = 0; //since the last death
+    while (num_generations == generation) {
+        if (max_frames != 0 && frames >= max_frames) { //nobody dies anymore, score everyone where they are
+            for (unsigned i = 0; i < generation_size; ++i) {
+                world.alive[i] = 0;
+                kill(i);
+                respawn(i);
+            }
+            count_generations();
+            frames = 0;
+            continue;
+        }
+        unsigned long long born = births;
+        bounce_off_wall(x, y, w, h);
+        update();
+        frames = births == born ? frames + 1 : 0;
+    }
+    return last_fitness;
+}
+
+void NetworkHandler::checkpoint(string path) {
+    Checkpoint state;
+    state.params = network_params;
+    state.mutation_rate = mutation_rate;
+    state.generation_size = generation_size;
+    state.num_generations = num_generations;
+    state.seed = seed;
+    state.genome_length = networks[0]->genome_size();
+
+    state.networks.resize((size_t)generation_size * state.genome_length);
+    for (unsigned i = 0; i < generation_size; ++i) {
+        memcpy(state.networks.data() + (size_t)i * state.genome_length, networks[i]->get_genome(), state.genome_length * sizeof(float));
+    }
+    for (unsigned i = 0; i < best_networks.size(); ++i) {
+        const float* genome = best_networks.network(i)->get_genome();
+        state.best_genomes.insert(state.best_genomes.end(), genome, genome + state.genome_length);
+        state.best_fitness.push_back(best_networks.fitness(i));
+    }
+    checkpoint_writer.write(path, move(state));
+}
+
+bool NetworkHandler::resume(string path) {
+    Checkpoint state;
+    if (!state.read(path)) {
+        return false;
+    }
+    if (state.params.inputs != network_params.inputs || state.params.outputs != network_params.outputs ||
+        state.params.hidden_layers != network_params.hidden_layers || state.params.hidden_layer_size != network_params.hidden_layer_size ||
+        state.generation_size != generation_size) {
+        throw("the checkpoint was written for a different topology or generation size\n");
+    }
+
+    if (!batch) {
+        batch = new BatchedNetwork(network_params, generation_size);
+    }
+    clear();
+    for (unsigned i = 0; i < generation_size; ++i) {
+        networks[i] = network_pool.acquire();
+        networks[i]->set_genome(state.networks.data() + (size_t)i * state.genome_length);
+        batch->load(i, networks[i]);
+    }
+    best_networks.clear();
+    for (unsigned i = 0; i < state.best_fitness.size(); ++i) {
+        NeuralNetwork* nn = network_pool.acquire();
+        nn->set_genome(state.best_genomes.data() + (size_t)i * state.genome_length);
+        network_pool.release(best_networks.offer(nn, state.best_fitness.at(i)));
+    }
+    world.reset();
+
+    mutation_rate = state.mutation_rate;
+    num_generations = state.num_generations;
+    seed = state.seed;
+    births = (unsigned long long)(num_generations - 1) * generation_size; //checkpoints are written on generation boundaries
+    frame = 0;
+    fittest = 0;
+    num_alive = generation_size;
+    for (unsigned i = 0; i < config.num_rendered && i < generation_size; ++i) {
+        rendered_indices.push_back(i);
+    }
+    cout << "resumed generation #" << num_generations << " from " << path << endl;
+    return true;
+}
+
+void NetworkHandler::emigrants(unsigned n, vector<float> & genomes, vector<float> & fitness) {
+    vector<pair<NeuralNetwork*, float>> fittest_networks = best_networks.sorted();
+    genomes.clear();
+    fitness.clear();
+    for (unsigned i = 0; i < n && i < fittest_networks.size(); ++i) {
+        const float* genome = fittest_networks.at(i).first->get_genome();
+        genomes.insert(genomes.end(), genome, genome + fittest_networks.at(i).first->genome_size());
+        fitness.push_back(fittest_networks.at(i).second);
+    }
+}
+
+void NetworkHandler::immigrate(const vector<float> & genomes) {
+    unsigned length = networks[0]->genome_size();
+    unsigned count = genomes.size() / length;
+    for (unsigned k = 0; k < count && k < generation_size; ++k) {
+        unsigned i = generation_size - 1 - k;
+        networks[i]->set_genome(genomes.data() + (size_t)k * length);
+        batch->load(i, networks[i]);
+        if (steady_state) { //the pair is mid game, the immigrant starts its own
+            world.reset(i);
+            world.serve(i);
+            actions[i] = DECIDE;
+        }
+    }
+}
+
+void NetworkHandler::keep(const vector<float> & genomes, const vector<float> & fitness) {
+    for (unsigned k = 0; k < fitness.size(); ++k) {
+        NeuralNetwork* nn = network_pool.acquire();
+        nn->set_genome(genomes.data() + (size_t)k * nn->genome_size());
+        network_pool.release(best_networks.offer(nn, fitness.at(k)));
+    }
+}
+
+void NetworkHandler::bounce_off_wall(int x, int y, int w, int h) {
+    pool.parallel_for(generation_size, CHUNK_SIZE, [this, x, y, w, h](unsigned begin, unsigned end) {
+        Random chunk_rng(Random::mix(seed, num_generations, frame, begin));
+        world.bounce_off_wall(x, y, w, h, begin, end, chunk_rng);
+    });
+}
+
+vector<unsigned> & NetworkHandler::get_rendered_indices() {
+    for (unsigned i = 0; i < rendered_indices.size(); ++i) {
+        if (!world.alive[rendered_indices.at(i)]) {
+            for (unsigned j = 0; j < generation_size; ++j) {
+                if (!has(rendered_indices, j) && world.alive[j]) {
+                    rendered_indices.at(i) = j;
+                    break;
+                }
+            }
+        }
+    }
+    return rendered_indices;
+}
+
+void NetworkHandler::save(unsigned num_saves) {
+    string file_name;
+    if (num_saves > 1) {
+        string new_folder("../saves/save_state_");
+        Random id(summnation());
+        unsigned ID_SIZE = 10;
+        for (unsigned i = 0; i < ID_SIZE; ++i) {
+            if (id.below(2) == 0) {
+                new_folder += (char)(id.below(26) + 'a');
+            }
+            else {
+                new_folder += (char)(id.below(10) + '0');
+            }
+        }
+        error_code error;
+        if (!filesystem::create_directories(new_folder, error)) {
+            cout << "could not create new directory" << endl;
+        }
+        file_name += new_folder;
+        file_name += "/";
+    }
+    else {
+        file_name += "../../saves/";
+    }
+    if (num_saves > best_networks.size()) {
+        num_saves = best_networks.size();
+    }
+
+    //fittest first, so loading the file as a single network picks the best one
+    vector<pair<NeuralNetwork*, float>> fittest_networks = best_networks.sorted();
+
+    vector<const float*> genomes;
+    vector<float> scores;
+    for (unsigned i = 0; i < num_saves; ++i) {
+        float score = fittest_networks.at(i).second-3;
+        if (score < 0) score = 0;
+        genomes.push_back(fittest_networks.at(i).first->get_genome());
+        scores.push_back(score);
+    }
+
+    if (num_saves > 1) { //the whole population goes in one file
+        file_name += "population.genome";
+        GenomeFile::Header header = fittest_networks.at(0).first->header(num_generations);
+        if (GenomeFile::write(file_name, header, genomes, scores)) {
+            cout << file_name << endl;
+        }
+    }
+    else if (num_saves == 1) {
+        fittest_networks.at(0).first->save(file_name, scores.at(0), num_generations);
+    }
+}
+
+Sensor::State NetworkHandler::sensor_state(unsigned i) {
+    Sensor::State state;
+    state.ball_x = world.ball_x[i];
+    state.ball_y = world.ball_y[i];
+    state.ball_vel_x = world.ball_vel_x[i];
+    state.ball_vel_y = world.ball_vel_y[i];
+    state.ball_speed = world.ball_speed;
+    state.player_x = world.paddle_x;
+    state.player_y = world.paddle_y[i];
+    return state;
+}
+
+unsigned NetworkHandler::step_chunk(unsigned begin, unsigned end, unsigned long long frame, float* inputs, float* outputs) {
+    bool decide = decision_interval <= 1 || (frame - 1) % decision_interval == 0;
+    bool deciding = false;
+    for (unsigned i = begin; i < end; ++i) {
+        if (world.alive[i] && (decide || actions[i] == DECIDE)) {
+            Sensor::set_activations(sensor_state(i), inputs, network_params.inputs, config.ball_speed);
+            batch->set_inputs(i, inputs);
+            deciding = true;
+        }
+    }
+
+    //in between decisions nobody is sensed or evaluated
+    if (deciding) {
+        batch->forward_propagation(begin, end);
+    }
+
+    for (unsigned i = begin; i < end; ++i) {
+        if (world.alive[i]) {
+            if (decide || actions[i] == DECIDE) {
+                batch->get_outputs(i, outputs);
+                actions[i] = AI::choose(outputs);
+            }
+            world.move_paddle(i, (World::Action)actions[i]);
+        }
+    }
+
+    return world.step(begin, end, died.data() + begin);
+}
+
+float NetworkHandler::kill(unsigned index) {
+    float fitness = world.fitness[index];
+    if (fitness < 50) {
+        fitness += world.num_movements(index);
+    }
+
+    network_pool.release(best_networks.offer(networks[index], fitness));
+    networks[index] = nullptr;
+    last_fitness[index] = fitness;
+
+    if (fittest < fitness) {
+        fittest = fitness;
+    }
+    //cout << "save finished" << endl;
+
+    --num_alive;
+    return fitness;
+}
+
+void NetworkHandler::end_generation() {
+    clear();
+    if (!quiet) {
+        clear_screen();
+        cout << "most fit: " << fittest << endl;
+    }
+    for (unsigned i = 0; i < best_networks.size(); ++i) {
+        if (best_networks.fitness(i) > fittest) {
+            fittest = best_networks.fitness(i);
+        }
+    }
+    if (!quiet) {
+        cout << "most fit: " << fittest << endl;
+        cout << "breeding a new generation" << endl;
+    }
+    breed_new_generation();
+    if (!quiet) {
+        cout << "this is generation #" << num_generations << endl;
+    }
+    for (unsigned i = 0; i < config.num_rendered && i < generation_size; ++i) { //only render the first few players
+        rendered_indices.push_back(i);
+    }
+    //cout << "breeding a new generation" << endl;
+    serve();
+
+    if (checkpoint_interval != 0 && num_generations % checkpoint_interval == 0) {
+        checkpoint(checkpoint_path);
+    }
+}
+
+void NetworkHandler::respawn(unsigned index) {
+    networks[index] = network_pool.acquire();
+    Random child_rng(Random::mix(seed, births, 0, STEADY_STREAM));
+    breed_child(index, births % generation_size, child_rng);
+    batch->load(index, networks[index]);
+    world.reset(index);
+    world.serve(index);
+    actions[index] = DECIDE;
+    ++births;
+    ++num_alive;
+}
+
+void NetworkHandler::count_generations() {
+    while (births >= (unsigned long long)num_generations * generation_size) {
+        ++num_generations;
+        frame = 0;
+        best_networks.decay(0.1);
+        if (!quiet) {
+            cout << "most fit: " << fittest << ", this is generation #" << num_generations << endl;
+        }
+        fittest = 0;
+        if (checkpoint_interval != 0 && num_generations % checkpoint_interval == 0) {
+            checkpoint(checkpoint_path);
+        }
+    }
+}
+
+void NetworkHandler::clear() {
+    for (unsigned i = 0; i < generation_size; ++i) {
+        network_pool.release(networks[i]);
+        networks[i] = nullptr;
+    }
+    rendered_indices.clear();
+}
+
+void NetworkHandler::breed_new_generation() {
+    // for (unsigned i = 0; i < best_networks.size(); ++i) {
+    //     best_networks.at(i).first->forward_propagation();
+    // }
+
+    //the pool isn't thread safe, so every slot gets its network up front
+    for (unsigned i = 0; i < generation_size; ++i) {
+        networks[i] = network_pool.acquire();
+    }
+    //best_networks is only read while the children are bred, and every child draws from its own
+    //stream, so the generation doesn't depend on the thread count or which thread bred which child
+    unsigned generation = num_generations;
+    pool.parallel_for(generation_size, CHUNK_SIZE, [this, generation](unsigned begin, unsigned end) {
+        for (unsigned i = begin; i < end; ++i) {
+            Random child_rng(Random::mix(seed, generation, i, BREED_STREAM));
+            breed_child(i, i, child_rng);
+            batch->load(i, networks[i]);
+        }
+    });
+    ++num_generations;
+    frame = 0;
+    world.reset();
+
+    best_networks.decay(0.1);
+
+    rendered_indices.clear();
+    fittest = 0;
+    num_alive = generation_size;
+}
+
+void NetworkHandler::breed_child(unsigned i, unsigned kind, Random & rng) {
+    if (kind < best_networks.size()) {
+        networks[i]->share(best_networks.network(kind)); //no copy, the elite's genes don't change
+        //
+        //networks[i] = new NeuralNetwork("../saves/save_state_w1amn7x1h9/4_3_1_5_score4081_7g4ey57126");
+        //
+    }
+    else if (kind % 3 == 0) {
+        unsigned mutation_index = rng.uniform(0, best_networks.size()-0.1);
+
+        if (best_networks.fitness(mutation_index) < 15) {
+            networks[i]->randomize(rng);
+        }
+        else {
+            networks[i]->breed(best_networks.network(mutation_index), best_networks.network(mutation_index), mutation_rate, rng);
+        }
+    }
+    else {
+        unsigned dad_index = rng.uniform(0, best_networks.size()-1);
+        unsigned mom_index = rng.uniform(0, best_networks.size()-1);
+
+        networks[i]->breed(best_networks.network(dad_index), best_networks.network(mom_index), mutation_rate, rng);
+    }
+}
+
+int NetworkHandler::summnation() {
+    float summnation = 0;
+    for (unsigned i = 0; i < best_networks.size(); ++i) {
+        summnation += best_networks.fitness(i);
+    }
+    return summnation;
+}
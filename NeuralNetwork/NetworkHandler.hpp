@@ -2,351 +2,198 @@
 #define __NETWORK_HANDLER_H__
 
 #include "NeuralNetwork.hpp"
-#include "../Pong/Ball.hpp"
-#include "../Pong/Player.hpp"
+#include "BatchedNetwork.hpp"
+#include "../Pong/World.hpp"
 #include "Sensor.hpp"
-#include "AI.hpp"
+#include "ThreadPool.hpp"
+#include "Checkpoint.hpp"
+#include "Random.hpp"
+#include "ElitePool.hpp"
+#include "NetworkPool.hpp"
+#include "../config.hpp"
 
-#include <ctime>
 #include <vector>
-#include <math.h>
-#include <utility>      // std::pair, std::make_pair
 #include <string>
-#include <fstream>
 
 using namespace std;
 
-float HEIGHT_RATIO = 8;
-
-bool has(vector<unsigned> v, unsigned item);
-float fRand(float fMin, float fMax);
-
 class NetworkHandler {
 friend class NHTests;
+friend class Benchmarks;
+friend class IslandModelTests;
 private:
+    Config config; //what the run was started with, resume() takes the mutation rate and seed from the checkpoint
     NetworkParams network_params;
     float mutation_rate;
     unsigned generation_size;
 
     vector<unsigned> rendered_indices;
-    vector<pair<NeuralNetwork*, float>> best_networks; // pair<neural_net, fitness
+    NetworkPool network_pool; //networks that aren't playing or kept, handed out again every generation
+    ElitePool best_networks;  //the config.num_fittest fittest networks that died so far
     unsigned num_alive;
     unsigned prev_alive;
 
-    Ball** balls;
-    Player** players; //player holds ais
+    World world;                     //every paddle/ball pair of the generation
+    vector<unsigned> died;           //pairs that died this frame, chunk c writes from c * CHUNK_SIZE
+    vector<unsigned> num_died;       //per chunk
+    vector<float> chunk_inputs;      //per chunk, scratch_size(inputs) floats step_chunk senses into
+    vector<float> chunk_outputs;     //per chunk, scratch_size(outputs) floats
+    vector<NeuralNetwork*> networks; //networks[i] plays pair i of the world
+
+    BatchedNetwork* batch; //every network of the generation, evaluated in one pass
+
+    ThreadPool pool; //paddle/ball pairs are independent, so each generation is stepped in parallel, on config.threads threads
+    static const unsigned CHUNK_SIZE = 64; //paddles per unit of work
 
     float fittest;
     unsigned num_generations;
 
+    unsigned seed;          //every random number of a run derives from it, see Random::mix
+    Random rng;             //the first generation's networks, seeded from seed
+    static const uint64_t BREED_STREAM = ~0ull; //last counter of the children's streams, chunk offsets never reach it
+    static const uint64_t STEADY_STREAM = ~1ull; //the same for the children bred one at a time in steady state
+    bool steady_state;        //see respawn()
+    unsigned long long births; //children bred one at a time so far, generation_size of them make a generation
+    vector<float> last_fitness; //per pair, the fitness its last network died with
+    unsigned decision_interval; //networks are evaluated every decision_interval frames, see step_chunk()
+    vector<unsigned char> actions; //per pair, the move repeated until its next decision
+    static const unsigned char DECIDE = 0xFF; //in actions: the pair decides on its next frame, whatever the interval
+    unsigned long long frame; //frames into the current generation, seeds the wall bounces
+    string checkpoint_path;
+    unsigned checkpoint_interval; //generations between checkpoints, 0 never writes one
+    CheckpointWriter checkpoint_writer;
+    bool quiet; //no progress on the console, for handlers that run side by side (see IslandModel)
+
 public:
-    NetworkHandler(unsigned inputs, unsigned outputs, unsigned hidden_layers, unsigned hidden_layer_size, float mutation_rate, unsigned generation_size):
-    mutation_rate(mutation_rate), generation_size(generation_size), num_alive(generation_size), prev_alive(0), fittest(0), num_generations(0) {
-        network_params.inputs = inputs;
-        network_params.outputs = outputs;
-        network_params.hidden_layers = hidden_layers;
-        network_params.hidden_layer_size = hidden_layer_size;
-    }
+    //topology, population, mutation rate, selection and the game's speeds and paddle size
+    //all come from config, the handler is seeded with config.seed
+    NetworkHandler(const Config & config);
+
+    //the default config with another topology, mutation rate and population
+    NetworkHandler(unsigned inputs, unsigned outputs, unsigned hidden_layers, unsigned hidden_layer_size, float mutation_rate, unsigned generation_size);
 
     NetworkHandler(NetworkParams & params, float mutation_rate, unsigned generation_size):
     NetworkHandler(params.inputs, params.outputs, params.hidden_layers, params.hidden_layer_size, mutation_rate, generation_size) {}
 
-    void init_networks() {
-        balls = new Ball*[generation_size];
-        players = new Player*[generation_size];
-        for (unsigned i = 0; i < generation_size; ++i) {
-            balls[i] = new Ball();
-            // if (i <= 10) {
-            //     players[i] = new Player(new AI(new Sensor(balls[i]), new NeuralNetwork("../saves/save_state_w1amn7x1h9/4_3_1_5_score4081_7g4ey57126")),32,(HEIGHT/2)-(HEIGHT/8),(HEIGHT/HEIGHT_RATIO),12);
-            // }
-            // else {
-                players[i] = new Player(new AI(new Sensor(balls[i]), network_params), 32,(HEIGHT/2)-(HEIGHT/8),(HEIGHT/HEIGHT_RATIO),12);
-            //}
-            players[i]->randomize_color();
-            balls[i]->set_color(players[i]->get_color());
-        }
-
-        for (unsigned i = 0; i < NUM_RENDERED_AIS; ++i) { //only render the first 5 players
-            rendered_indices.push_back(i);
-        }
-        ++num_generations;
+    ~NetworkHandler();
+
+    void init_networks();
+
+    void update();
+
+    //plays the rest of the generation without rendering and breeds the next one, returns the
+    //fitness every pair of the finished generation died with.
+    //each chunk of pairs plays frame after frame on its own thread until all of its paddles are
+    //dead, instead of waiting on the other chunks every frame. pairs still alive after max_frames
+    //(0 has no limit) are killed where they are. (x, y, w, h) is the left wall, which doesn't move.
+    //the result is the same as calling bounce_off_wall(x, y, w, h) and update() until the generation ends.
+    //in steady state it plays frame by frame until generation_size more children were born instead, and
+    //returns the fitness each pair's last network died with (0 if none did). if nobody dies for
+    //max_frames frames, every pair is killed and replaced where it is
+    vector<float> evaluate(int x, int y, int w, int h, unsigned long long max_frames = 0);
+
+    //writes a checkpoint every interval generations, once the new generation is bred
+    void set_checkpoint(string path, unsigned interval) {
+        checkpoint_path = path;
+        checkpoint_interval = interval;
     }
 
-    void update() {
-        for (unsigned i = 0; i < generation_size; ++i) {
-            if (players[i] && balls[i]) {
-                //cout << "input " << i << endl;
-                players[i]->get_input();
-                //cout << "got input" << endl;
-                update(players[i], balls[i]);
-            }
-        }
-        if (clock() % 50 == 0 && num_alive != prev_alive) {
-            //system("CLS");
-            cout << "num alive: " << num_alive << endl;
-            prev_alive = num_alive;
-        }
-
-        if (num_alive == 0) {
-            clear();
-            system("CLS");
-
-            cout << "most fit: " << fittest << endl;
-            for (unsigned i = 0; i < best_networks.size(); ++i) {
-                if (best_networks.at(i).second > fittest) {
-                    fittest = best_networks.at(i).second;
-                }
-            }
-            cout << "most fit: " << fittest << endl;
-            cout << "breeding a new generation" << endl;
-            breed_new_generation();
-            cout << "this is generation #" << num_generations << endl;
-            for (unsigned i = 0; i < NUM_RENDERED_AIS; ++i) { //only render the first 5 players
-                rendered_indices.push_back(i);
-            }
-            //cout << "breeding a new generation" << endl;
-            serve();
-        }
+    //snapshots the generation and every kept network, the file is written in the background.
+    //meant to be called between generations, e.g. right after init_networks() or resume()
+    void checkpoint(string path);
+
+    //blocks until the last checkpoint is on disk
+    void wait_for_checkpoint() {
+        checkpoint_writer.wait();
+    }
+
+    //replaces init_networks() to continue a run from a checkpoint. serve() afterwards as usual.
+    //returns false if there is no checkpoint at path, throws if it belongs to a different run
+    bool resume(string path);
+
+    //copies the n fittest kept genomes into genomes back to back, fittest first, and their fitness into fitness
+    void emigrants(unsigned n, vector<float> & genomes, vector<float> & fitness);
+
+    //genomes (back to back) replace the last networks of the generation that is about to play.
+    //meant to be called between generations
+    void immigrate(const vector<float> & genomes);
+
+    //offers genomes (back to back) to the kept networks as if networks with that fitness had died
+    void keep(const vector<float> & genomes, const vector<float> & fitness);
+
+    void set_quiet(bool quiet) {
+        this->quiet = quiet;
     }
 
-    Ball** getBalls() {
-        return balls;
+    void set_seed(unsigned seed) {
+        this->seed = seed;
+    }
+    unsigned get_seed() {
+        return seed;
+    }
+
+    //Train's left wall: sends the balls that touch it back and moves every ball.
+    //each chunk draws its bounce angles from its own stream, so they don't depend on the thread that runs it
+    void bounce_off_wall(int x, int y, int w, int h);
+
+    World & get_world() {
+        return world;
+    }
+    const Config & get_config() {
+        return config;
     }
     unsigned size() {
         return generation_size;
     }
 
-    vector<Object*> getObjects() {
-        vector<Object*> objects;
-        for (unsigned i = 0; i < rendered_indices.size(); ++i) {
-            unsigned index = rendered_indices.at(i);
-            if (players[index]) {
-                objects.push_back(players[index]);
-                objects.push_back(balls[index]);
-            }
-            else {
-                for (unsigned j = 0; j < generation_size; ++j) {
-                    if (!has(rendered_indices, j) && players[j]) {
-                        rendered_indices.at(i) = j;
-                    }
-                }
-            }
-        }
-        return objects;
-    }
+    //pairs to draw, dead ones are swapped for pairs that are still alive
+    vector<unsigned> & get_rendered_indices();
 
     void serve() {
-        for (unsigned i = 0; i < generation_size; ++i) {
-            players[i]->setX(WIDTH-32);
-
-            // balls[i]->setX(players[i]->getX()+(players[i]->getW()*4));
-            balls[i]->setX(players[i]->getX()-(players[i]->getW()*4 + 200));
-            balls[i]->setVelX(balls[i]->getSpeed()/-2);
-
-            balls[i]->setVelY(0);
-            balls[i]->setY((HEIGHT/2)-8);
-        }
+        world.serve();
     }
 
     unsigned get_nth_generation() {
         return num_generations;
     }
 
-    void save(unsigned num_saves) {
-        string file_name;
-        if (num_saves > 1) {
-            wstring new_folder(L"../saves/save_state_");
-            srand(summnation());
-            unsigned ID_SIZE = 10;
-            for (unsigned i = 0; i < ID_SIZE; ++i) {
-                if (rand() % 2 == 0) {
-                    new_folder += rand() % 26 + 'a';
-                }
-                else {
-                    new_folder += rand() % 10 + '0';
-                }
-            }
-            if (_wmkdir(new_folder.c_str()) == -1) {
-                cout << "could not create new directory" << endl;
-            }
-            string temp(new_folder.begin(), new_folder.end());
-            file_name += temp;
-            file_name += "/";
-        }
-        else {
-            file_name += "../../saves/";
-        }
-        for (unsigned i = 0; i < num_saves; ++i) {
-            int score = best_networks.at(i).second-3;
-            if (score < 0) score = 0;
-            best_networks.at(i).first->save(file_name, score);
-        }
-        srand(time(0));
-    }
+    void save(unsigned num_saves);
 private:
-    void update(Player* paddle, Ball* ball) {
-        SDL_Rect b = ball->getRect();
-        SDL_Rect p = paddle->getRect();
-        if(SDL_HasIntersection(&b, &p)) {                                                  //checks if ball and paddle interact
-            double rel = (paddle->getY()+(paddle->getH()/2))-(ball->getY()+8);
-            double norm = rel/(paddle->getH()/2);
-            double bounce = norm * (5*PI/12);
-            ball->setVelX((ball->getSpeed()*-1)*cos(bounce));                               //sends ball at different angle based on where the ball has hit the paddle
-            ball->setVelY((ball->getSpeed())*-sin(bounce));
-            if (paddle->getY() != paddle->get_previousY()) {
-                paddle->increment_fittness();
-            }
-            paddle->set_previousY(paddle->getY());
-        }
-
-        if(ball->getY()<=0 || ball->getY()+16>=HEIGHT) ball->setVelY(ball->getVelY()*-1);       //check to see if ball hit top or bottom walls
-        ball->setX(ball->getVelX()+ball->getX());                                               //ball movement;
-        ball->setY(ball->getVelY()+ball->getY());
-
-        if(paddle->getY()<0) paddle->setY(0);                                       // boundaries for paddles
-        if(paddle->getY() + paddle->getH()>HEIGHT) paddle->setY(HEIGHT-paddle->getH());
-
-        if(ball->getX()+16>=WIDTH) kill(paddle, ball);
-    }
+    Sensor::State sensor_state(unsigned i);
 
-    void kill(Player* paddle, Ball* ball) {
-        float fitness = paddle->get_fitness();
-        if (fitness < 50) {
-            fitness += paddle->getController()->get_fitness();
-        }
-        if (best_networks.size() < NUM_FITTEST) {
-            NeuralNetwork* nn = new NeuralNetwork((paddle->getController()->getNetwork()), network_params);
-            best_networks.push_back(make_pair(nn, fitness));
-        }
-        else {
-            for (unsigned i = 0; i < best_networks.size(); ++i) {
-                if (*best_networks.at(i).first == *paddle->getController()->getNetwork()) {
-                    if (fitness > best_networks.at(i).second) {
-                        best_networks.at(i).second = fitness;
-                    }
-                    //if (fitness > 100) best_networks.at(i).second = (best_networks.at(i).second + fitness) / 2.0;
-                    //else best_networks.at(i).second -= 0.1;
-                    break;
-                }
-                if (best_networks.at(i).second <= fitness) {
-                    //cout << best_networks.size() << endl;
-                    //cout << fitness << " saving network" << endl;
-                    NeuralNetwork* nn = new NeuralNetwork((paddle->getController()->getNetwork()), network_params);
-
-                    if (best_networks.at(i).first) {
-                        delete best_networks.at(i).first;
-                    }
-                    best_networks.at(i) = make_pair(nn, fitness);
-                    break;
-                }
-            }
-        }
-        if (fittest < fitness) {
-            fittest = fitness;
-        }
-        //cout << "save finished" << endl;
-
-        for (unsigned i = 0; i < generation_size; ++i) {
-            if (players[i] == paddle) {
-
-                delete players[i];
-                delete balls[i];
-
-                players[i] = nullptr;
-                balls[i] = nullptr;
-                break;
-            }
-        }
-        --num_alive;
-    }
+    //senses, decides and steps pairs [begin, end) one frame, returns how many died. died + begin gets their indices.
+    //frame counts from 1 at the start of the generation: the networks are only sensed and evaluated every
+    //decision_interval frames and the pairs repeat their last move in between
+    unsigned step_chunk(unsigned begin, unsigned end, unsigned long long frame, float* inputs, float* outputs);
 
-    void clear() {
-        for (unsigned i = 0; i < generation_size; ++i) {
-            if (balls[i]) {
-                // cout << "asdjfklasfasdf" << endl;
-                delete balls[i];
-            }
-            if (players[i]) {
-                // cout << "asdnfjasjdfkl" << endl;
-                delete players[i];
-            }
-        }
-        delete [] balls;
-        delete [] players;
-        rendered_indices.clear();
-    }
+    //the network is handed to the elite pool, whichever network that leaves goes back to network_pool.
+    //returns the pair's fitness
+    float kill(unsigned index);
 
-    void breed_new_generation() {
-        // for (unsigned i = 0; i < best_networks.size(); ++i) {
-        //     best_networks.at(i).first->forward_propagation();
-        // }
-
-        cout << best_networks.size() << endl;
-        ++num_generations;
-        balls = new Ball*[generation_size];
-        players = new Player*[generation_size];
-        for (unsigned i = 0; i < generation_size; ++i) {
-            balls[i] = new Ball();
-            if (i < best_networks.size()) {
-                players[i] = new Player(new AI(new Sensor(balls[i]), new NeuralNetwork(best_networks.at(i).first, network_params)), 32,(HEIGHT/2)-(HEIGHT/8),(HEIGHT/HEIGHT_RATIO),12);
-                //
-                //players[i] = new Player(new AI(new Sensor(balls[i]), new NeuralNetwork("../saves/save_state_w1amn7x1h9/4_3_1_5_score4081_7g4ey57126")),32,(HEIGHT/2)-(HEIGHT/8),(HEIGHT/HEIGHT_RATIO),12);
-                //
-            }
-            else if (i % 3 == 0) {
-                unsigned mutation_index = fRand(0, best_networks.size()-0.1);
-
-                if (best_networks.at(mutation_index).second < 15) {
-                    players[i] = new Player(new AI(new Sensor(balls[i]), new NeuralNetwork(network_params)), 32,(HEIGHT/2)-(HEIGHT/8),(HEIGHT/HEIGHT_RATIO),12);
-                }
-                else {
-                    AI* child = new AI(new Sensor(balls[i]), network_params, best_networks.at(mutation_index).first, best_networks.at(mutation_index).first, mutation_rate);
-                    players[i] = new Player(child, 32,(HEIGHT/2)-(HEIGHT/8),(HEIGHT/HEIGHT_RATIO),12);
-                }
-            }
-            else {
-                unsigned dad_index = fRand(0, best_networks.size()-1);
-                unsigned mom_index = fRand(0, best_networks.size()-1);
-
-                AI* child = new AI(new Sensor(balls[i]), network_params, best_networks.at(dad_index).first, best_networks.at(mom_index).first, mutation_rate);
-                child->getNetwork()->forward_propagation();
-                players[i] = new Player(child, 32,(HEIGHT/2)-(HEIGHT/8),(HEIGHT/HEIGHT_RATIO),12);
-            }
-            players[i]->randomize_color();
-            players[i]->randomize_color();
-            balls[i]->set_color(players[i]->get_color());
-        }
-
-        for (unsigned i = 0; i < best_networks.size(); ++i) {
-            best_networks.at(i).second -= 0.1;
-        }
-
-        rendered_indices.clear();
-        fittest = 0;
-        num_alive = generation_size;
-    }
+    //every paddle is dead: breeds and serves the next generation
+    void end_generation();
 
-    int summnation() {
-        float summnation = 0;
-        for (unsigned i = 0; i < best_networks.size(); ++i) {
-            summnation += best_networks.at(i).second;
-        }
-        return summnation;
-    }
-};
+    //steady state: the dead pair's slot gets a child of the current elite pool right away and is served
+    //again, so there is no generation barrier. children draw from their own stream by birth number,
+    //and deaths are handled in the same order as ever, so a run is still deterministic
+    void respawn(unsigned index);
 
-bool has(vector<unsigned> v, unsigned item) {
-    for (unsigned i = 0; i < v.size(); ++i) {
-        if (v.at(i) == item) {
-            return true;
-        }
-    }
-    return false;
-}
+    //steady state: counts a generation for every generation_size births, decays the elite pool and checkpoints.
+    //called once the frame's dead pairs are all refilled, so a checkpoint never sees an empty slot
+    void count_generations();
+
+    vector<float> evaluate_steady(int x, int y, int w, int h, unsigned long long max_frames);
 
-float fRand(float fMin, float fMax) {
-    float f = (float)rand() / RAND_MAX;
-    return fMin + f * (fMax - fMin);
-}
+    void clear();
+
+    //breeds the next generation on the thread pool, a chunk of children per thread
+    void breed_new_generation();
+
+    //breeds the network in slot i. kind picks what it is, as if it were slot kind of a generation:
+    //a copy of an elite, a mutant, or a child of two elites
+    void breed_child(unsigned i, unsigned kind, Random & rng);
+
+    int summnation();
+};
 
 #endif
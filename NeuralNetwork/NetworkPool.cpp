@@ -0,0 +1,24 @@
+#include "NetworkPool.hpp"
+
+using namespace std;
+
+NetworkPool::~NetworkPool() {
+    for (unsigned i = 0; i < spare.size(); ++i) {
+        delete spare.at(i);
+    }
+}
+
+NeuralNetwork* NetworkPool::acquire() {
+    if (spare.empty()) {
+        return new NeuralNetwork(params, (const float*)nullptr);
+    }
+    NeuralNetwork* nn = spare.back();
+    spare.pop_back();
+    return nn;
+}
+
+void NetworkPool::release(NeuralNetwork* nn) {
+    if (nn) {
+        spare.push_back(nn);
+    }
+}
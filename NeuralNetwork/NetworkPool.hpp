@@ -0,0 +1,41 @@
+#ifndef __NETWORK_POOL_HPP__
+#define __NETWORK_POOL_HPP__
+
+#include "NeuralNetwork.hpp"
+
+#include <vector>
+
+using namespace std;
+
+// Networks of one topology that are allocated once and handed out again every generation.
+//
+// A network is several allocations (its parameter block and the views into it), so
+// instead of deleting a generation and allocating the next one the handler releases
+// its networks here and acquires them back, then fills them in place with
+// randomize(), breed() or set_genome().
+class NetworkPool {
+private:
+    NetworkParams params;
+    vector<NeuralNetwork*> spare;
+
+public:
+    NetworkPool(NetworkParams params): params(params) {}
+
+    ~NetworkPool();
+
+    NetworkPool(const NetworkPool &) = delete;
+    NetworkPool & operator=(const NetworkPool &) = delete;
+
+    //a network whose genes are left over from its last use, only allocates when none are free
+    NeuralNetwork* acquire();
+
+    //the pool owns nn again, nullptr is ignored
+    void release(NeuralNetwork* nn);
+
+    //networks waiting to be handed out
+    unsigned available() const {
+        return spare.size();
+    }
+};
+
+#endif
@@ -0,0 +1,361 @@
+#include "NeuralNetwork.hpp"
+#include "Genetics.hpp"
+
+#include <fstream>
+#include <iostream>
+
+using namespace std;
+
+NeuralNetwork::NeuralNetwork(unsigned inputs, unsigned outputs, unsigned hidden_layers, unsigned hidden_layer_size, Random & rng):
+inputs(inputs),  outputs(outputs), hidden_layer_size(hidden_layer_size) {
+    num_layers = hidden_layers + 2;
+    allocate();
+    randomize(rng);
+}
+
+NeuralNetwork::NeuralNetwork(unsigned inputs, unsigned outputs, unsigned hidden_layers, unsigned hidden_layer_size, NeuralNetwork* nn1, NeuralNetwork* nn2, float mutation_rate, Random & rng):
+inputs(inputs),  outputs(outputs), hidden_layer_size(hidden_layer_size) {
+    num_layers = hidden_layers + 2;
+    allocate();
+    breed(nn1, nn2, mutation_rate, rng);
+}
+
+NeuralNetwork::NeuralNetwork(NeuralNetwork* nn, NetworkParams & params):
+inputs(params.inputs),  outputs(params.outputs), hidden_layer_size(params.hidden_layer_size) {
+    num_layers = params.hidden_layers + 2;
+    allocate();
+
+    //biases and weights are shared until either network changes them
+    share(nn);
+}
+
+NeuralNetwork::NeuralNetwork(NetworkParams & params, const float* genome):
+inputs(params.inputs),  outputs(params.outputs), hidden_layer_size(params.hidden_layer_size) {
+    num_layers = params.hidden_layers + 2;
+    allocate();
+
+    if (genome) {
+        set_genome(genome);
+    }
+}
+
+void NeuralNetwork::randomize(Random & rng) {
+    unshare(false);
+    //initializing the weights in the adjacency matrices
+    for (unsigned index = 0; index < num_layers-1; ++index) {
+        init_layer(index, layer_size(index+1), layer_size(index), rng);
+    }
+
+    //initializing the biases and activations
+    for (unsigned i = 0; i < num_layers; ++i) {
+        init_nodes(i, layer_size(i), rng);
+    }
+}
+
+void NeuralNetwork::breed(const NeuralNetwork* nn1, const NeuralNetwork* nn2, float mutation_rate, Random & rng) {
+    //biases and weights are bred in one pass over the flat genomes.
+    //the parents' genes are read before unshare(), which may swap out this network's block when it is a parent
+    const float* a = nn1->get_genome();
+    const float* b = nn2->get_genome();
+    Genetics::breed(a, b, unshare(false), genome_length, mutation_rate, rng);
+}
+
+void NeuralNetwork::share(const NeuralNetwork* nn) {
+    if (nn->genome == genome) {
+        return;
+    }
+    GenomeBlock* block = nn->genome->acquire();
+    genome->release();
+    genome = block;
+    point_views();
+}
+
+float* NeuralNetwork::unshare(bool keep) {
+    if (!genome->shared()) {
+        return genome->writable_data();
+    }
+    GenomeBlock* block = GenomeBlock::create(genome_length);
+    if (keep) {
+        memcpy(block->writable_data(), genome->data(), genome_length * sizeof(float));
+    }
+    genome->release();
+    genome = block;
+    point_views();
+    return block->writable_data();
+}
+
+NeuralNetwork::NeuralNetwork(string directory) {
+    if (GenomeFile::is_binary(directory)) {
+        GenomeFile::Header header;
+        vector<float> genomes;
+        vector<float> fitness;
+        if (!GenomeFile::read(directory, header, genomes, fitness)) {
+            throw("could not read the genome file\n");
+        }
+
+        //checked before allocate(), the destructor doesn't run if the constructor throws
+        if (header.count == 0 || header.genome_length == 0 ||
+            header.genome_length != genome_length_of(header.inputs, header.outputs, header.hidden_layers, header.hidden_layer_size)) {
+            throw("the genome file does not match its topology\n");
+        }
+
+        inputs = header.inputs;
+        outputs = header.outputs;
+        num_layers = header.hidden_layers + 2;
+        hidden_layer_size = header.hidden_layer_size;
+        allocate();
+        set_genome(genomes.data());
+        return;
+    }
+
+    ifstream fin(directory);
+    if (!fin.is_open()) {
+        cout << "could not open file: " << directory << endl;
+    }
+
+    fin >> inputs;
+    fin >> outputs;
+    fin >> num_layers;
+    num_layers += 2;
+    fin >> hidden_layer_size;
+
+    if (!fin || genome_length_of(inputs, outputs, num_layers - 2, hidden_layer_size) == 0) {
+        throw("could not read the network's topology\n");
+    }
+    allocate();
+
+    //the file holds the biases followed by the weights, the same order as the genome
+    float* genes = unshare(false);
+    for (unsigned i = 0; i < genome_length; ++i) {
+        fin >> genes[i];
+    }
+}
+
+string NeuralNetwork::save(string directory, unsigned fitness, unsigned generation) const {
+    Random id(this->summnation()); //the same network always gets the same name
+
+    string file_name = directory;
+    file_name += to_string(inputs);
+    file_name += "_";
+    file_name += to_string(outputs);
+    file_name += "_";
+    file_name += to_string(num_layers - 2);
+    file_name += "_";
+    file_name += to_string(hidden_layer_size);
+    file_name += "_";
+    file_name += "score";
+    file_name += to_string(fitness);
+    file_name += "_";
+
+    unsigned ID_SIZE = 10;
+    for (unsigned i = 0; i < ID_SIZE; ++i) {
+        if (id.below(2) == 0) {
+            file_name += id.below(26) + 'a';
+        }
+        else {
+            file_name += id.below(10) + '0';
+        }
+    }
+    file_name += ".genome";
+    cout << file_name << endl;
+
+    vector<const float*> genomes(1, get_genome());
+    vector<float> scores(1, (float)fitness);
+    GenomeFile::write(file_name, header(generation), genomes, scores);
+
+    return file_name;
+}
+
+GenomeFile::Header NeuralNetwork::header(unsigned generation) const {
+    GenomeFile::Header header;
+    header.inputs = inputs;
+    header.outputs = outputs;
+    header.hidden_layers = num_layers - 2;
+    header.hidden_layer_size = hidden_layer_size;
+    header.generation = generation;
+    header.genome_length = genome_length;
+    return header;
+}
+
+int NeuralNetwork::summnation() const {
+    float summnation = 0;
+    const float* genes = get_genome();
+    for (unsigned i = 0; i < genome_length; ++i) {
+        summnation += genes[i];
+    }
+
+    return summnation;
+}
+
+bool NeuralNetwork::operator==(const NeuralNetwork & nn) const {
+    if (genome_length != nn.genome_size()) return false;
+    if (genome == nn.genome) return true; //shared
+
+    const float* genes = get_genome();
+    const float* other = nn.get_genome();
+    for (unsigned i = 0; i < genome_length; ++i) {
+        if (genes[i] != other[i]) return false;
+    }
+
+    return true;
+}
+
+void NeuralNetwork::print_activations() {
+    std::cout << "activations:\n";
+    for(unsigned i = 0; i < num_layers; ++i) {
+        unsigned size = hidden_layer_size;
+        if ( i == 0) {
+            size = inputs;
+        }
+        else if (i == num_layers-1) {
+            size = outputs;
+        }
+        for (unsigned j = 0; j < size; ++j) {
+            std::cout<< activations[i][j] << ' ';
+        }
+        std::cout << '\n';
+    }
+    std::cout << '\n';
+}
+
+void NeuralNetwork::print_biases() {
+    std::cout << "biases:\n";
+    for(unsigned i = 0; i < num_layers; ++i) {
+        unsigned size = hidden_layer_size;
+        if ( i == 0) {
+            size = inputs;
+        }
+        else if (i == num_layers-1) {
+            size = outputs;
+        }
+        for (unsigned j = 0; j < size; ++j) {
+            std::cout<< biases[i][j] << ' ';
+        }
+        std::cout << '\n';
+    }
+    std::cout << '\n';
+}
+
+void NeuralNetwork::print_weights() {
+    std::cout << "weights:-----------------------------------------------------------------------------------------------------------------------------------\n";
+    for (unsigned index = 0; index < num_layers-1; ++index) {
+        unsigned rows = hidden_layer_size;
+        unsigned cols = hidden_layer_size;
+        if (index == 0) {
+            cols = inputs;
+        }
+        if (index == num_layers-2) {
+            rows = outputs;
+        }
+        for (unsigned i = 0; i < rows; ++i) {
+            for (unsigned j = 0; j < cols; ++j) {
+                std::cout << adjacency_matrices[index][i][j] << ' ';
+            }
+            std::cout << '\n';
+        }
+        std::cout << '\n';
+    }
+    std::cout << "----------------------------------------------------------------------------------------------------------------------------------------------\n";
+}
+
+NeuralNetwork::~NeuralNetwork() {
+    //std::cout << "destructor called" << std::endl;
+    delete[] adjacency_matrices;
+    delete[] weight_rows;
+    delete[] weights;
+    delete[] biases;
+    delete[] activations;
+    operator delete[](activation_block, align_val_t(ALIGNMENT));
+    genome->release();
+}
+
+unsigned long long NeuralNetwork::genome_length_of(unsigned long long inputs, unsigned long long outputs, unsigned long long hidden_layers, unsigned long long hidden_layer_size) {
+    const unsigned long long LIMIT = 0xFFFFFFFFull; //genome lengths are 32 bit in the files
+    if (inputs == 0 || outputs == 0 || hidden_layers == 0 || hidden_layer_size == 0 ||
+        inputs > LIMIT || outputs > LIMIT || hidden_layers > LIMIT || hidden_layer_size > LIMIT) {
+        return 0;
+    }
+    //the biases of every layer, then every adjacency matrix
+    //every factor is below 2^32 and each product is checked before it grows, so nothing overflows
+    unsigned long long nodes = inputs + hidden_layers * hidden_layer_size + outputs;
+    unsigned long long columns = inputs + (hidden_layers - 1) * hidden_layer_size + outputs; //weights per hidden node
+    if (nodes > LIMIT || columns > LIMIT) {
+        return 0;
+    }
+    unsigned long long length = nodes + hidden_layer_size * columns;
+    return length > LIMIT ? 0 : length;
+}
+
+void NeuralNetwork::allocate() {
+    unsigned num_nodes = 0;
+    unsigned num_weights = 0;
+    unsigned num_rows = 0;
+    for (unsigned i = 0; i < num_layers; ++i) {
+        num_nodes += layer_size(i);
+    }
+    for (unsigned index = 0; index < num_layers-1; ++index) { //all layers have a adjacency matrix except for input layer
+        num_rows += layer_size(index+1);
+        num_weights += layer_size(index+1) * layer_size(index);
+    }
+
+    genome_length = num_nodes + num_weights;
+    genome = GenomeBlock::create(genome_length);
+
+    activation_block = static_cast<float*>(operator new[](num_nodes * sizeof(float), align_val_t(ALIGNMENT)));
+    memset(activation_block, 0, num_nodes * sizeof(float));
+
+    biases = new float*[num_layers];
+    activations = new float*[num_layers];
+    unsigned offset = 0;
+    for (unsigned i = 0; i < num_layers; ++i) {
+        activations[i] = activation_block + offset;
+        offset += layer_size(i);
+    }
+
+    adjacency_matrices = new float**[num_layers];
+    weight_rows = new float*[num_rows];
+    weights = new float*[num_layers];
+    point_views();
+}
+
+void NeuralNetwork::point_views() {
+    //the views are only ever read through while the block is shared, see get_weights()
+    float* genes = const_cast<float*>(genome->data());
+    unsigned offset = 0;
+    for (unsigned i = 0; i < num_layers; ++i) {
+        biases[i] = genes + offset;
+        offset += layer_size(i);
+    }
+
+    unsigned row = 0;
+    for (unsigned index = 0; index < num_layers-1; ++index) {
+        adjacency_matrices[index] = weight_rows + row;
+        weights[index] = genes + offset;
+        for (unsigned i = 0; i < layer_size(index+1); ++i) {
+            weight_rows[row++] = genes + offset;
+            offset += layer_size(index);
+        }
+    }
+}
+
+void NeuralNetwork::init_layer(unsigned index, unsigned rows, unsigned cols, Random & rng) {
+    for (unsigned i = 0; i < rows; ++i) {
+        for (unsigned j = 0; j < cols; ++j) {
+            adjacency_matrices[index][i][j] = rng.uniform(-1,1);
+        }
+    }
+}
+
+void NeuralNetwork::init_nodes(unsigned index, unsigned layer_size, Random & rng) {
+    for (unsigned i = 0; i < layer_size; ++i) {
+        if (index == 0) {
+            biases[index][i] = 0.0;
+        }
+        else {
+            biases[index][i] = rng.uniform(-1,1);
+        }
+        activations[index][i] = 0.0;
+        //std::cout << biases[index][i] << " | ";
+    }
+    //std::cout << "\n";
+}
@@ -2,14 +2,19 @@
 #define __NEURAL_NETWORK_HPP__
 
 #include "Matrix.h"
+#include "GenomeBlock.hpp"
+#include "GenomeFile.hpp"
+#include "Random.hpp"
 #include <iostream>
 #include <string>
-#include <fstream>
-#include <ctime>
 
 #include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <new>
 #include <utility>
 #include <type_traits>
+#include <vector>
 
 using namespace std;
 
@@ -32,326 +37,73 @@ private:
     unsigned outputs;
     unsigned hidden_layer_size;
 
-    float*** adjacency_matrices; //array of 2d arrays
+    // The genome is one aligned block laid out as
+    //   [ biases of every layer | weights of every layer (row major) ]
+    // in the same order as the save files, so breeding and saving a network walk a
+    // single flat array. The block is shared with every network that has the same
+    // genes and copied only when this network's genes change, see GenomeBlock.
+    // Activations are written on every forward pass, so they have a block of their own.
+    GenomeBlock* genome;
+    unsigned genome_length;
+    float* activation_block;
 
-    float** biases;
-    float** activations;
+    float*** adjacency_matrices; //array of 2d arrays, views into the genome
+    float** weight_rows;         //row pointers of every adjacency matrix
+    float** weights;             //first weight of every adjacency matrix, each one is row major
+
+    float** biases;      //views into the genome
+    float** activations; //views into activation_block
 
 public:
+    static const unsigned ALIGNMENT = 64; //bytes, one cache line
+
     //note: at least 1 hidden layer is required;
-    NeuralNetwork(unsigned inputs, unsigned outputs, unsigned hidden_layers, unsigned hidden_layer_size):
-    inputs(inputs),  outputs(outputs), hidden_layer_size(hidden_layer_size) {
-        num_layers = hidden_layers + 2;
-
-        //initializing the weights in the adjacency matrices
-        adjacency_matrices = new float**[num_layers]; //all layers have a adjacency matrix except for input layer
-        for (unsigned index = 0; index < num_layers-1; ++index) {
-            if (index == 0) { //first adjacency_matrix is under the second layer
-                adjacency_matrices[index] = new float*[hidden_layer_size];
-                init_layer(index, hidden_layer_size, inputs);
-            }
-
-            else if (index == num_layers-2) { //last adjacency matrix on the output layer
-                adjacency_matrices[index] = new float*[outputs];
-                init_layer(index, outputs, hidden_layer_size);
-            }
-
-            else { // hidden layers connected to hidden layers
-                adjacency_matrices[index] = new float*[hidden_layer_size];
-                init_layer(index, hidden_layer_size, hidden_layer_size);
-            }
-        }
+    //rng draws the starting weights and biases, by default this thread's Random::local()
+    NeuralNetwork(unsigned inputs, unsigned outputs, unsigned hidden_layers, unsigned hidden_layer_size, Random & rng = Random::local());
 
-        //initializing the biases and activations
-        biases = new float*[num_layers];
-        activations = new float*[num_layers];
-        for (unsigned i = 0; i < num_layers; ++i) {
-            if (i == 0) { //input layer
-                biases[i] = new float[inputs];
-                activations[i] = new float[inputs];
-                init_nodes(i, inputs);
-            }
-            else if (i == num_layers - 1) { //output layer
-                biases[i] = new float[outputs];
-                activations[i] = new float[outputs];
-                init_nodes(i, outputs);
-            }
-            else { //hidden_layers
-                biases[i] = new float[hidden_layer_size];
-                activations[i] = new float[hidden_layer_size];
-                init_nodes(i, hidden_layer_size);
-            }
-        }
+    NeuralNetwork(NetworkParams & params, Random & rng = Random::local()):
+    NeuralNetwork(params.inputs, params.outputs, params.hidden_layers, params.hidden_layer_size, rng) {}
 
+    NeuralNetwork(unsigned inputs, unsigned outputs, unsigned hidden_layers, unsigned hidden_layer_size, NeuralNetwork* nn1, NeuralNetwork* nn2, float mutation_rate, Random & rng = Random::local());
 
+    NeuralNetwork(NetworkParams & params, NeuralNetwork* nn1, NeuralNetwork* nn2, float mutation_rate, Random & rng = Random::local()):
+    NeuralNetwork(params.inputs, params.outputs, params.hidden_layers, params.hidden_layer_size, nn1, nn2, mutation_rate, rng) {}
 
-    }
+    //shares nn's genome, nothing is copied until one of the two changes its genes
+    NeuralNetwork(NeuralNetwork* nn, NetworkParams & params);
 
-    NeuralNetwork(NetworkParams & params): NeuralNetwork(params.inputs, params.outputs, params.hidden_layers, params.hidden_layer_size) {}
-
-    NeuralNetwork(unsigned inputs, unsigned outputs, unsigned hidden_layers, unsigned hidden_layer_size, NeuralNetwork* nn1, NeuralNetwork* nn2, float mutation_rate):
-    NeuralNetwork(inputs, outputs, hidden_layers, hidden_layer_size) {
-        for(unsigned i = 0; i < num_layers; ++i) {
-            unsigned size = hidden_layer_size;
-            if ( i == 0) {
-                size = inputs;
-            }
-            else if (i == num_layers-1) {
-                size = outputs;
-            }
-            for (unsigned j = 0; j < size; ++j) {
-                float new_bias = choose(nn1->get_biases()[i][j], nn2->get_biases()[i][j]);
-                biases[i][j] = mutate(new_bias, mutation_rate);
-            }
-        }
+    //genome holds genome_size() floats in the order of get_genome(), nullptr leaves every gene 0
+    NeuralNetwork(NetworkParams & params, const float* genome);
 
-        //copy weights
-        for (unsigned index = 0; index < num_layers-1; ++index) {
-            unsigned rows = hidden_layer_size;
-            unsigned cols = hidden_layer_size;
-            if (index == 0) {
-                cols = inputs;
-            }
-            if (index == num_layers-2) {
-                rows = outputs;
-            }
-            for (unsigned i = 0; i < rows; ++i) {
-                for (unsigned j = 0; j < cols; ++j) {
-                    float new_weight = choose(nn1->get_weights()[index][i][j], nn2->get_weights()[index][i][j]);
-                    adjacency_matrices[index][i][j] = mutate(new_weight, mutation_rate);
-                }
-            }
-        }
-    }
-
-    NeuralNetwork(NetworkParams & params, NeuralNetwork* nn1, NeuralNetwork* nn2, float mutation_rate):
-    NeuralNetwork(params.inputs, params.outputs, params.hidden_layers, params.hidden_layer_size, nn1, nn2, mutation_rate) {}
-
-    NeuralNetwork(NeuralNetwork* nn, NetworkParams & params): NeuralNetwork(params.inputs, params.outputs, params.hidden_layers, params.hidden_layer_size) {
-        //copy biases
-        //nn->print_biases();
-        // std::cout << "saving weights + biases" << std::endl;
-        for(unsigned i = 0; i < num_layers; ++i) {
-            unsigned size = hidden_layer_size;
-            if ( i == 0) {
-                size = inputs;
-            }
-            else if (i == num_layers-1) {
-                size = outputs;
-            }
-            for (unsigned j = 0; j < size; ++j) {
-                biases[i][j] = nn->get_biases()[i][j];
-            }
-        }
+    //the constructors' work redone in place, so a NetworkPool can hand the same network out every generation.
+    //the networks given have to share this one's topology
+    void randomize(Random & rng = Random::local());
 
-        //copy weights
-        for (unsigned index = 0; index < num_layers-1; ++index) {
-            unsigned rows = hidden_layer_size;
-            unsigned cols = hidden_layer_size;
-            if (index == 0) {
-                cols = inputs;
-            }
-            if (index == num_layers-2) {
-                rows = outputs;
-            }
-            for (unsigned i = 0; i < rows; ++i) {
-                for (unsigned j = 0; j < cols; ++j) {
-                    adjacency_matrices[index][i][j] = nn->get_weights()[index][i][j];
-                }
-            }
-        }
+    void breed(const NeuralNetwork* nn1, const NeuralNetwork* nn2, float mutation_rate, Random & rng = Random::local());
 
-        //std::cout << "done" << std::endl;
+    void set_genome(const float* genome) {
+        memcpy(unshare(false), genome, genome_length * sizeof(float));
     }
 
-    NeuralNetwork(string directory) {
-        ifstream fin(directory);
-        if (!fin.is_open()) {
-            cout << "could not open file: " << directory << endl;
-        }
+    //takes nn's genes without copying them, the two share a genome until either one changes.
+    //nn has to share this one's topology
+    void share(const NeuralNetwork* nn);
 
-        fin >> inputs;
-        fin >> outputs;
-        fin >> num_layers;
-        num_layers += 2;
-        fin >> hidden_layer_size;
-
-        //initializing the biases and activations
-        biases = new float*[num_layers];
-        activations = new float*[num_layers];
-        for (unsigned i = 0; i < num_layers; ++i) {
-            if (i == 0) { //input layer
-                biases[i] = new float[inputs];
-                activations[i] = new float[inputs];
-                for (unsigned j = 0; j < inputs; ++j) {
-                    fin >> biases[i][j];
-                }
-            }
-            else if (i == num_layers - 1) { //output layer
-                biases[i] = new float[outputs];
-                activations[i] = new float[outputs];
-                init_nodes(i, outputs);
-                for (unsigned j = 0; j < outputs; ++j) {
-                    fin >> biases[i][j];
-                }
-            }
-            else { //hidden_layers
-                biases[i] = new float[hidden_layer_size];
-                activations[i] = new float[hidden_layer_size];
-                for (unsigned j = 0; j < hidden_layer_size; ++j) {
-                    fin >> biases[i][j];
-                }
-            }
-        }
-
-        //initializing the weights in the adjacency matrices
-        adjacency_matrices = new float**[num_layers]; //all layers have a adjacency matrix except for input layer
-        for (unsigned index = 0; index < num_layers-1; ++index) {
-            if (index == 0) { //first adjacency_matrix is under the second layer
-                adjacency_matrices[index] = new float*[hidden_layer_size];
-                //init_layer(index, hidden_layer_size, inputs);
-                for (unsigned i = 0; i < hidden_layer_size; ++i) {
-                    adjacency_matrices[index][i] = new float[inputs];
-                    for (unsigned j = 0; j < inputs; ++j) {
-                        fin >> adjacency_matrices[index][i][j];
-                    }
-                }
-            }
-
-            else if (index == num_layers-2) { //last adjacency matrix on the output layer
-                adjacency_matrices[index] = new float*[outputs];
-                //init_layer(index, outputs, hidden_layer_size);
-                for (unsigned i = 0; i < outputs; ++i) {
-                    adjacency_matrices[index][i] = new float[hidden_layer_size];
-                    for (unsigned j = 0; j < hidden_layer_size; ++j) {
-                        fin >> adjacency_matrices[index][i][j];
-                    }
-                }
-            }
-
-            else { // hidden layers connected to hidden layers
-                adjacency_matrices[index] = new float*[hidden_layer_size];
-                //init_layer(index, hidden_layer_size, hidden_layer_size);
-                for (unsigned i = 0; i < hidden_layer_size; ++i) {
-                    adjacency_matrices[index][i] = new float[hidden_layer_size];
-                    for (unsigned j = 0; j < hidden_layer_size; ++j) {
-                        fin >> adjacency_matrices[index][i][j];
-                    }
-                }
-            }
-        }
+    //networks that carry this network's genome block, this one included
+    unsigned genome_use_count() const {
+        return genome->use_count();
     }
 
-    string save(string directory, unsigned fitness) const {
-        srand(this->summnation());
-
-        string file_name = directory;
-        file_name += to_string(inputs);
-        file_name += "_";
-        file_name += to_string(outputs);
-        file_name += "_";
-        file_name += to_string(num_layers - 2);
-        file_name += "_";
-        file_name += to_string(hidden_layer_size);
-        file_name += "_";
-        file_name += "score";
-        file_name += to_string(fitness);
-        file_name += "_";
-
-        unsigned ID_SIZE = 10;
-        for (unsigned i = 0; i < ID_SIZE; ++i) {
-            if (rand() % 2 == 0) {
-                file_name += rand() % 26 + 'a';
-            }
-            else {
-                file_name += rand() % 10 + '0';
-            }
-        }
-
-        ofstream fout;
-        fout.open(file_name);
-        if (!fout.is_open()) {
-            cout << "could not open file" << endl;
-        }
-        cout << file_name << endl;
-
-        fout << inputs << ' ';
-        fout << outputs << ' ';
-        fout << num_layers-2 << ' ';
-        fout << hidden_layer_size << endl;
-
-        //writing weights
-        for(unsigned i = 0; i < num_layers; ++i) {
-            unsigned size = hidden_layer_size;
-            if ( i == 0) {
-                size = inputs;
-            }
-            else if (i == num_layers-1) {
-                size = outputs;
-            }
-            for (unsigned j = 0; j < size; ++j) {
-                fout << biases[i][j] << ' ';
-            }
-        }
-        fout << endl;
-
-        //writing biases
-        for (unsigned index = 0; index < num_layers-1; ++index) {
-            unsigned rows = hidden_layer_size;
-            unsigned cols = hidden_layer_size;
-            if (index == 0) {
-                cols = inputs;
-            }
-            if (index == num_layers-2) {
-                rows = outputs;
-            }
-            for (unsigned i = 0; i < rows; ++i) {
-                for (unsigned j = 0; j < cols; ++j) {
-                    fout << adjacency_matrices[index][i][j] << ' ';
-                }
-            }
-        }
-        fout << endl;
-
-        fout.close();
+    //reads binary genome files and the older text saves. a population file gives its first network
+    NeuralNetwork(string directory);
 
-        srand(time(0));
-        return file_name;
-    }
-    int summnation() const {
-        float summnation = 0;
-        for(unsigned i = 0; i < num_layers; ++i) {
-            unsigned size = hidden_layer_size;
-            if ( i == 0) {
-                size = inputs;
-            }
-            else if (i == num_layers-1) {
-                size = outputs;
-            }
-            for (unsigned j = 0; j < size; ++j) {
-                summnation += biases[i][j];
-            }
-        }
+    //writes a binary genome file named after the topology and fitness, returns its path
+    string save(string directory, unsigned fitness, unsigned generation = 0) const;
 
-        //copy weights
-        for (unsigned index = 0; index < num_layers-1; ++index) {
-            unsigned rows = hidden_layer_size;
-            unsigned cols = hidden_layer_size;
-            if (index == 0) {
-                cols = inputs;
-            }
-            if (index == num_layers-2) {
-                rows = outputs;
-            }
-            for (unsigned i = 0; i < rows; ++i) {
-                for (unsigned j = 0; j < cols; ++j) {
-                    summnation += adjacency_matrices[index][i][j];
-                }
-            }
-        }
+    //header of a genome file for networks with this topology
+    GenomeFile::Header header(unsigned generation) const;
 
-        return summnation;
-    }
+    int summnation() const;
 
     float* get_inputs() {
         return activations[0];
@@ -365,208 +117,74 @@ public:
 
     void forward_propagation() {
         for (unsigned index = 1; index < num_layers; ++index) {
-            float* solution;
-            unsigned size;
-            if (index == 1) { //input layer -> hidden layer
-                size = hidden_layer_size;
-                delete[] activations[index]; //delete before reassigning
-                activations[index] = Matrix::multiply(adjacency_matrices[index-1], activations[index-1], hidden_layer_size, inputs);
-            }
-            else if (index == num_layers-1) { //hidden layer -> output layer
-                size = outputs;
-                delete[] activations[index];
-                activations[index] = Matrix::multiply(adjacency_matrices[index-1], activations[index-1], outputs, hidden_layer_size);
-            }
-            else { //hidden layer -> hidden layer
-                size = hidden_layer_size;
-                delete[] activations[index];
-                activations[index] = Matrix::multiply(adjacency_matrices[index-1], activations[index-1], hidden_layer_size, hidden_layer_size);
-            }
-
-            for (unsigned i = 0; i < size; ++i) {
-                activations[index][i] += biases[index][i];
-                activations[index][i] = Matrix::ReLU(activations[index][i]);
-            }
+            //each adjacency matrix is one row major block, written straight into the preallocated layer
+            unsigned size = layer_size(index);
+            Matrix::multiply_into(weights[index-1], activations[index-1], activations[index], size, layer_size(index-1));
+            Matrix::bias_ReLU(activations[index], biases[index], size);
         }
     }
 
-    bool operator==(const NeuralNetwork & nn) const {
-        for(unsigned i = 0; i < num_layers; ++i) {
-            unsigned size = hidden_layer_size;
-            if ( i == 0) {
-                size = inputs;
-            }
-            else if (i == num_layers-1) {
-                size = outputs;
-            }
-            for (unsigned j = 0; j < size; ++j) {
-                if (biases[i][j] != nn.get_biases()[i][j]) return false;
-            }
-        }
-
-        //copy weights
-        for (unsigned index = 0; index < num_layers-1; ++index) {
-            unsigned rows = hidden_layer_size;
-            unsigned cols = hidden_layer_size;
-            if (index == 0) {
-                cols = inputs;
-            }
-            if (index == num_layers-2) {
-                rows = outputs;
-            }
-            for (unsigned i = 0; i < rows; ++i) {
-                for (unsigned j = 0; j < cols; ++j) {
-                    if (adjacency_matrices[index][i][j] != nn.get_weights()[index][i][j]) return false;
-                }
-            }
-        }
+    bool operator==(const NeuralNetwork & nn) const;
 
-        return true;
+    //FNV-1a over the genome bits, equal genomes always hash the same.
+    //worked out once per genome block, so a shared elite isn't hashed again
+    uint64_t hash() const {
+        return genome->hash();
     }
 
-    float*** get_weights() const {
+    //views into the genome, which may be shared, so they are read only. see set_genome() to change them
+    const float* const* const* get_weights() const {
         return adjacency_matrices;
     }
-    const float*** get_weights() {
-        return (const float***)(adjacency_matrices);
-    }
-    float** get_biases() const {
+    const float* const* get_biases() const {
         return biases;
     }
-    const float** get_biases() {
-        return (const float**)(biases);
+    //biases followed by weights, genome_size() floats long. see set_genome() to change them
+    const float* get_genome() const {
+        return genome->data();
+    }
+    unsigned genome_size() const {
+        return genome_length;
     }
+
     NetworkParams get_params() {
         NetworkParams params(inputs, outputs, num_layers-2, hidden_layer_size);
         return params;
     }
 
-    void print_activations() {
-        std::cout << "activations:\n";
-        for(unsigned i = 0; i < num_layers; ++i) {
-            unsigned size = hidden_layer_size;
-            if ( i == 0) {
-                size = inputs;
-            }
-            else if (i == num_layers-1) {
-                size = outputs;
-            }
-            for (unsigned j = 0; j < size; ++j) {
-                std::cout<< activations[i][j] << ' ';
-            }
-            std::cout << '\n';
-        }
-        std::cout << '\n';
-    }
-    void print_biases() {
-        std::cout << "biases:\n";
-        for(unsigned i = 0; i < num_layers; ++i) {
-            unsigned size = hidden_layer_size;
-            if ( i == 0) {
-                size = inputs;
-            }
-            else if (i == num_layers-1) {
-                size = outputs;
-            }
-            for (unsigned j = 0; j < size; ++j) {
-                std::cout<< biases[i][j] << ' ';
-            }
-            std::cout << '\n';
-        }
-        std::cout << '\n';
-    }
-    void print_weights() {
-        std::cout << "weights:-----------------------------------------------------------------------------------------------------------------------------------\n";
-        for (unsigned index = 0; index < num_layers-1; ++index) {
-            unsigned rows = hidden_layer_size;
-            unsigned cols = hidden_layer_size;
-            if (index == 0) {
-                cols = inputs;
-            }
-            if (index == num_layers-2) {
-                rows = outputs;
-            }
-            for (unsigned i = 0; i < rows; ++i) {
-                for (unsigned j = 0; j < cols; ++j) {
-                    std::cout << adjacency_matrices[index][i][j] << ' ';
-                }
-                std::cout << '\n';
-            }
-            std::cout << '\n';
-        }
-        std::cout << "----------------------------------------------------------------------------------------------------------------------------------------------\n";
-    }
+    //genes of a network with this topology, 0 if it isn't one (no hidden layer or an empty layer).
+    //meant to check a file's topology before anything is allocated for it
+    static unsigned long long genome_length_of(unsigned long long inputs, unsigned long long outputs, unsigned long long hidden_layers, unsigned long long hidden_layer_size);
 
-    ~NeuralNetwork() {
-        //std::cout << "destructor called" << std::endl;
-        for (unsigned index = 0; index < num_layers-1; ++index) {
-            unsigned rows = hidden_layer_size;
-            unsigned cols = hidden_layer_size;
-            if (index == 0) {
-                cols = inputs;
-            }
-            if (index == num_layers-2) {
-                rows = outputs;
-            }
-            for (unsigned i = 0; i < rows; ++i) {
-                delete[] adjacency_matrices[index][i];
-            }
-            delete[] adjacency_matrices[index];
-        }
-        delete[] adjacency_matrices;
+    void print_activations();
+    void print_biases();
+    void print_weights();
 
-        for(unsigned i = 0; i < num_layers; ++i) {
-            delete[] biases[i];
-            delete[] activations[i];
-        }
-        delete[] biases;
-        delete[] activations;
-    }
+    ~NeuralNetwork();
 private:
-    float fRand(float fMin, float fMax) {
-        float f = (float)rand() / RAND_MAX;
-        return fMin + f * (fMax - fMin);
-    }
-    float choose(float x, float y) {
-        if (fRand(-1,1) > 0) {
-            return x;
+    unsigned layer_size(unsigned layer) const {
+        if (layer == 0) { //input layer
+            return inputs;
+        }
+        else if (layer == num_layers - 1) { //output layer
+            return outputs;
         }
-        return y;
+        return hidden_layer_size; //hidden_layers
     }
 
-    float mutate(float x, float mutation_rate) {
-        float identifier = fRand(0,1);
-
-        if (identifier <= mutation_rate) {
-            x += fRand(-1,1);
-        }
+    //allocates the genome and activation blocks and points every view into them
+    void allocate();
 
-        return x;
+    //points the bias and weight views into the current genome block
+    void point_views();
 
-    }
+    //gives this network a genome block nobody else refers to and returns its genes to write.
+    //keep copies the shared genes over, otherwise a new block is left at 0 for the caller to fill
+    float* unshare(bool keep);
 
-    void init_layer(unsigned index, unsigned rows, unsigned cols) {
-        for (unsigned i = 0; i < rows; ++i) {
-            adjacency_matrices[index][i] = new float[cols];
-            for (unsigned j = 0; j < cols; ++j) {
-                adjacency_matrices[index][i][j] = fRand(-1,1);
-            }
-        }
-    }
+    void init_layer(unsigned index, unsigned rows, unsigned cols, Random & rng);
 
-    void init_nodes(unsigned index, unsigned layer_size) {
-        for (unsigned i = 0; i < layer_size; ++i) {
-            if (index == 0) {
-                biases[index][i] = 0.0;
-            }
-            else {
-                biases[index][i] = fRand(-1,1);
-            }
-            activations[index][i] = 0.0;
-            //std::cout << biases[index][i] << " | ";
-        }
-        //std::cout << "\n";
-    }
+    void init_nodes(unsigned index, unsigned layer_size, Random & rng);
 
 };
 
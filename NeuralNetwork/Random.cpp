@@ -0,0 +1,19 @@
+#include "Random.hpp"
+
+#include <chrono>
+#include <functional>
+#include <random>
+#include <thread>
+
+using namespace std;
+
+uint64_t Random::entropy() {
+    random_device device;
+    uint64_t time = chrono::high_resolution_clock::now().time_since_epoch().count();
+    return mix(((uint64_t)device() << 32) ^ device(), time, hash<thread::id>()(this_thread::get_id()));
+}
+
+Random & Random::local() {
+    thread_local Random random(entropy());
+    return random;
+}
@@ -0,0 +1,84 @@
+#ifndef __RANDOM_HPP__
+#define __RANDOM_HPP__
+
+#include <cstdint>
+
+using namespace std;
+
+// A small, fast generator (xoshiro256**) that is passed to whatever needs
+// randomness instead of sharing the global rand() state.
+//
+// Every generator is seeded through splitmix64, so nearby seeds still give
+// unrelated streams. mix() turns a seed plus a few counters (generation, frame,
+// chunk, ...) into the seed of an independent stream, which lets parallel code
+// draw numbers that don't depend on which thread ran which piece of work.
+class Random {
+private:
+    uint64_t state[4];
+
+public:
+    explicit Random(uint64_t seed = 0) {
+        this->seed(seed);
+    }
+
+    void seed(uint64_t seed) {
+        for (unsigned i = 0; i < 4; ++i) {
+            state[i] = splitmix(seed);
+        }
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    //[0, 1)
+    float uniform() {
+        return (next() >> 40) * (1.0f / 16777216.0f);
+    }
+
+    //[min, max)
+    float uniform(float min, float max) {
+        return min + uniform() * (max - min);
+    }
+
+    //[0, n)
+    unsigned below(unsigned n) {
+        return ((next() >> 32) * n) >> 32;
+    }
+
+    static uint64_t mix(uint64_t seed, uint64_t a, uint64_t b = 0, uint64_t c = 0) {
+        uint64_t x = seed;
+        x = splitmix(x) ^ a;
+        x = splitmix(x) ^ b;
+        x = splitmix(x) ^ c;
+        return splitmix(x);
+    }
+
+    //a seed that differs from run to run, for when reproducibility isn't wanted
+    static uint64_t entropy();
+
+    //this thread's generator for code nobody passed one to, seeded from entropy()
+    static Random & local();
+
+private:
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static uint64_t splitmix(uint64_t & x) {
+        uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
+};
+
+#endif
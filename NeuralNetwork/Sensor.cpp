@@ -0,0 +1,151 @@
+#include "Sensor.hpp"
+
+#include <cmath>
+
+using namespace std;
+
+void Sensor::set_activations(const State & state, float* activations, unsigned inputs, double ball_speed) {
+    switch (inputs) {
+        case 3:
+            //set_3_activations(state, activations);
+            op_3(state, activations);
+            break;
+        case 4:
+            set_4_activations(state, activations, ball_speed);
+            break;
+        case 5:
+            set_5_activations(state, activations, ball_speed);
+            break;
+        case 6:
+            set_6_activations(state, activations, ball_speed);
+            break;
+        default:
+            throw("the neural network does not have the correct ammount of inputs\n");
+    }
+}
+
+void Sensor::set_3_activations(const State & state, float* activations) {
+    activations[0] = normalize(state.ball_x, 32, WIDTH - 32);
+    // cout << activations[0] << endl;
+    activations[1] = normalize(state.ball_y, 0, HEIGHT);
+    activations[2] = normalize(state.player_y, 0, HEIGHT);
+}
+
+void Sensor::op_3(const State & state, float* activations) {
+    // cout << activations[0] << endl;
+    // cout << ball->getVelX() << ' ' << ball->getX() << endl;
+    if (state.ball_vel_x > 0 && state.ball_x < state.player_x) {
+        double y_guess = intercept_y(state);
+        activations[0] = normalize(state.ball_x, 32, WIDTH - 32);
+        activations[1] = normalize(y_guess, 0, HEIGHT);
+        activations[2] = normalize(state.player_y, 0, HEIGHT);
+    }
+    else {
+        activations[0] = 0;
+        activations[1] = 0;
+        activations[2] = normalize(state.player_y, 0, HEIGHT);
+    }
+}
+
+double Sensor::intercept_y(const State & state) {
+    //step_intercept_y works in float, so the prediction starts from the same floats
+    const double ball_x = (float)state.ball_x;
+    const double ball_y = (float)state.ball_y;
+    const double vel_x = (float)state.ball_vel_x;
+    const double vel_y = (float)state.ball_vel_y;
+    if (vel_x <= 0 || ball_x >= state.player_x) {
+        return ball_y;
+    }
+    double steps = ceil((state.player_x - ball_x) / vel_x);
+
+    //the loop rounds x and y to float every frame, so they drift from the exact values used here by
+    //at most half an ulp a frame. where that is enough to change the frame count or whether the ball
+    //is at a wall, only the loop itself knows the answer. that takes a point within slack of a wall or
+    //of player_x, which is rare unless vel_y is tiny
+    const double ROUNDING = 1.0 / (1 << 24); //half an ulp, relative to the value rounded
+    double x_slack = (steps + 1) * (fabs(ball_x) + fabs(state.player_x) + vel_x) * ROUNDING;
+    if (state.player_x - (ball_x + (steps - 1) * vel_x) <= x_slack || ball_x + steps * vel_x - state.player_x <= x_slack) {
+        return step_intercept_y(state);
+    }
+
+    double speed = fabs(vel_y);
+    if (speed == 0) {
+        return ball_y;
+    }
+    //the points closest to each wall, see below
+    double y_slack = (steps + 1) * (fabs(ball_y) + HEIGHT + speed) * ROUNDING;
+    double top = ball_y + round(-ball_y / speed) * speed;
+    double bottom = ball_y + round((HEIGHT - ball_y) / speed) * speed;
+    if (fabs(top) <= y_slack || fabs(bottom - HEIGHT) <= y_slack) {
+        return step_intercept_y(state);
+    }
+
+    //the first frame turns the ball around if it starts on or past a wall
+    double direction = vel_y > 0 ? 1 : -1;
+    if (ball_y <= 0 || ball_y >= HEIGHT) {
+        direction = -direction;
+    }
+    double y = ball_y + direction * speed;
+    steps -= 1;
+    if ((y <= 0 && ball_y <= 0) || (y >= HEIGHT && ball_y >= HEIGHT)) {
+        //still past the wall, it keeps turning around between the two points
+        return fmod(steps, 2) == 0 ? y : ball_y;
+    }
+
+    //turning points as multiples of speed away from ball_y, which keeps them exact
+    double low = floor(-ball_y / speed);               //last point at or above the top wall
+    double high = ceil((HEIGHT - ball_y) / speed);     //first point at or below the bottom wall
+    double index = direction + direction * steps - low;
+    return ball_y + (low + fold(index, high - low)) * speed;
+}
+
+double Sensor::step_intercept_y(const State & state) {
+    float x_guess = state.ball_x;
+    float y_guess = state.ball_y;
+    float velY = state.ball_vel_y;
+    while (x_guess < state.player_x) {
+        if (y_guess <= 0 || y_guess >= HEIGHT) {
+            velY = -velY;
+        }
+        y_guess += velY;
+        x_guess += state.ball_vel_x;
+    }
+    return y_guess;
+}
+
+double Sensor::fold(double y, double size) {
+    double m = fmod(y, 2 * size);
+    if (m < 0) {
+        m += 2 * size;
+    }
+    return m <= size ? m : 2 * size - m;
+}
+
+void Sensor::set_4_activations(const State & state, float* activations, double ball_speed) {
+    activations[0] = normalize(state.ball_x, 32, WIDTH - 32);
+    activations[1] = normalize(state.ball_y, 0, HEIGHT);
+    activations[2] = normalize(state.player_y, 0, HEIGHT);
+    activations[3] = normalize(state.ball_vel_x, -ball_speed + 2, ball_speed - 2);
+}
+
+void Sensor::set_5_activations(const State & state, float* activations, double ball_speed) {
+    activations[0] = normalize(state.ball_x, 32, WIDTH - 32);
+    activations[1] = normalize(state.ball_y, 0, HEIGHT);
+    activations[2] = normalize(state.ball_vel_x, -ball_speed + 2, ball_speed - 2);
+    activations[3] = normalize(state.ball_vel_y, -ball_speed + 2, ball_speed - 2);
+    activations[4] = normalize(state.player_y, 0, HEIGHT);
+
+    // for (unsigned i = 0; i < 5; ++i) {
+    //     std::cout << activations[i] << ' ';
+    // }
+    // std::cout << std::endl;
+}
+
+void Sensor::set_6_activations(const State & state, float* activations, double ball_speed) {
+    activations[0] = normalize(state.ball_x, 32, WIDTH - 32);
+    activations[1] = normalize(state.ball_y, 0, HEIGHT);
+    activations[2] = state.ball_speed;
+    activations[3] = normalize(state.ball_vel_x, -ball_speed, ball_speed);
+    activations[4] = normalize(state.ball_vel_y, -ball_speed, ball_speed);
+    activations[5] = normalize(state.player_y, 0, HEIGHT);
+}
@@ -1,101 +1,67 @@
 #ifndef __SENSOR_HPP__
 #define __SENSOR_HPP__
 
-#include "../Pong/Ball.hpp"
 #include "../definitions.hpp"
-#include <iostream>
+
+class Ball;
+class Player;
 
 class Sensor {
+public:
+    //everything a sensor reads about one paddle and its ball
+    struct State {
+        double ball_x;
+        double ball_y;
+        double ball_vel_x;
+        double ball_vel_y;
+        double ball_speed;
+        double player_x;
+        double player_y;
+    };
+
 private:
     Ball* ball;
+    double ball_speed; //the ball speed the network was trained with, ball velocities are read relative to it
 public:
-    Sensor(Ball* ball): ball(ball) {}
-
-    void set_activations(Player* player, float* activations, unsigned inputs) {
-        switch (inputs) {
-            case 3:
-                //set_3_activations(player, activations);
-                op_3(player, activations);
-                break;
-            case 4:
-                set_4_activations(player, activations);
-                break;
-            case 5:
-                set_5_activations(player, activations);
-                break;
-            case 6:
-                set_6_activations(player, activations);
-                break;
-            default:
-                throw("the neural network does not have the correct ammount of inputs\n");
-        }
-    }
+    Sensor(Ball* ball, double ball_speed = BALL_SPEED): ball(ball), ball_speed(ball_speed) {}
+
+    void set_activations(Player* player, float* activations, unsigned inputs);
+
+    //same readings straight from raw state, used by the training World which has no Ball or Player objects
+    static void set_activations(const State & state, float* activations, unsigned inputs, double ball_speed = BALL_SPEED);
 
     void set_ball(Ball* ball) { this->ball = ball; }
 private:
-    void set_3_activations(Player* player, float* activations) {
-        activations[0] = normalize(ball->getX(), 32, WIDTH - 32);
-        // cout << activations[0] << endl;
-        activations[1] = normalize(ball->getY(), 0, HEIGHT);
-        activations[2] = normalize(player->getY(), 0, HEIGHT);
-    }
+    static void set_3_activations(const State & state, float* activations);
 
-    void op_3(Player* player, float* activations) {
-        float x_guess = ball->getX();
-        float y_guess = ball->getY();
-        float velY = ball->getVelY();
-        // cout << activations[0] << endl;
-        // cout << ball->getVelX() << ' ' << ball->getX() << endl;
-        if (ball->getVelX() > 0 && ball->getX() < player->getX()) {
-            while (x_guess < player->getX()) {
-                if (y_guess <= 0 || y_guess >= HEIGHT) {
-                    velY = -velY;
-                }
-                y_guess += velY;
-                x_guess += ball->getVelX();
-            }
-            activations[0] = normalize(ball->getX(), 32, WIDTH - 32);
-            activations[1] = normalize(y_guess, 0, HEIGHT);
-            activations[2] = normalize(player->getY(), 0, HEIGHT);
-        }
-        else {
-            activations[0] = 0;
-            activations[1] = 0;
-            activations[2] = normalize(player->getY(), 0, HEIGHT);
-        }
-    }
+    static void op_3(const State & state, float* activations);
 
-    void set_4_activations(Player* player, float* activations) {
-        activations[0] = normalize(ball->getX(), 32, WIDTH - 32);
-        activations[1] = normalize(ball->getY(), 0, HEIGHT);
-        activations[2] = normalize(player->getY(), 0, HEIGHT);
-        activations[3] = normalize(ball->getVelX(), -BALL_SPEED + 2, BALL_SPEED - 2);
-    }
+public:
+    //y of the ball once it reaches player_x, moving right. predicts what stepping the ball there
+    //frame by frame (step_intercept_y) does in O(1):
+    //the ball only ever visits y + k * |vel_y| and turns around at the first of those points
+    //at or past a wall, so its path is a triangle wave over those points, and n frames ahead
+    //is the travel folded back between the two turning points.
+    //it starts from the same floats as the loop and takes the same number of frames and bounces,
+    //so the two only differ by the loop's float rounding of y, a small fraction of a pixel. where
+    //that rounding could change the frame count or a bounce, the loop is run instead
+    static double intercept_y(const State & state);
 
-    void set_5_activations(Player* player, float* activations) {
-        activations[0] = normalize(ball->getX(), 32, WIDTH - 32);
-        activations[1] = normalize(ball->getY(), 0, HEIGHT);
-        activations[2] = normalize(ball->getVelX(), -BALL_SPEED + 2, BALL_SPEED - 2);
-        activations[3] = normalize(ball->getVelY(), -BALL_SPEED + 2, BALL_SPEED - 2);
-        activations[4] = normalize(player->getY(), 0, HEIGHT);
-
-        // for (unsigned i = 0; i < 5; ++i) {
-        //     std::cout << activations[i] << ' ';
-        // }
-        // std::cout << std::endl;
-    }
+    //the reference frame by frame prediction intercept_y replaces
+    static double step_intercept_y(const State & state);
 
-    void set_6_activations(Player* player, float* activations) {
-        activations[0] = normalize(ball->getX(), 32, WIDTH - 32);
-        activations[1] = normalize(ball->getY(), 0, HEIGHT);
-        activations[2] = ball->getSpeed();
-        activations[3] = normalize(ball->getVelX(), -BALL_SPEED, BALL_SPEED);
-        activations[4] = normalize(ball->getVelY(), -BALL_SPEED, BALL_SPEED);
-        activations[5] = normalize(player->getY(), 0, HEIGHT);
-    }
+private:
+    //reflects y into [0, size]
+    static double fold(double y, double size);
+
+    static void set_4_activations(const State & state, float* activations, double ball_speed);
+
+    static void set_5_activations(const State & state, float* activations, double ball_speed);
+
+    static void set_6_activations(const State & state, float* activations, double ball_speed);
 
     template<typename T, typename U, typename V>
-    float normalize(T x, U min, V max) {
+    static float normalize(T x, U min, V max) {
         return ((float)x - min) / ((float)max - min);
     }
 };
@@ -0,0 +1,20 @@
+// The Sensor members that read the game's Ball and Player objects. They are part
+// of the game library, so the rest of Sensor builds into the core without SDL.
+
+#include "Sensor.hpp"
+#include "../Pong/Ball.hpp"
+#include "../Pong/Player.hpp"
+
+using namespace std;
+
+void Sensor::set_activations(Player* player, float* activations, unsigned inputs) {
+    State state;
+    state.ball_x = ball->getX();
+    state.ball_y = ball->getY();
+    state.ball_vel_x = ball->getVelX();
+    state.ball_vel_y = ball->getVelY();
+    state.ball_speed = ball->getSpeed();
+    state.player_x = player->getX();
+    state.player_y = player->getY();
+    set_activations(state, activations, inputs, ball_speed);
+}
@@ -0,0 +1,99 @@
+#include "ThreadPool.hpp"
+
+using namespace std;
+
+ThreadPool::ThreadPool(unsigned threads): job_id(0), busy(0), stopping(false), job(nullptr), count(0), chunk(1) {
+    if (threads == 0) {
+        threads = thread::hardware_concurrency();
+    }
+    if (threads == 0) {
+        threads = 1;
+    }
+    num_threads = threads;
+    queues.reset(new Queue[num_threads]);
+    for (unsigned i = 1; i < num_threads; ++i) {
+        workers.push_back(thread(&ThreadPool::worker_loop, this, i));
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    start_signal.notify_all();
+    for (unsigned i = 0; i < workers.size(); ++i) {
+        workers.at(i).join();
+    }
+}
+
+void ThreadPool::parallel_for(unsigned count, unsigned chunk, const function<void(unsigned, unsigned)> & body) {
+    if (count == 0) {
+        return;
+    }
+    if (chunk == 0) {
+        chunk = 1;
+    }
+    if (num_threads == 1 || count <= chunk) { //same chunks as the threaded path, so results don't depend on the thread count
+        for (unsigned begin = 0; begin < count; begin += chunk) {
+            body(begin, begin + chunk < count ? begin + chunk : count);
+        }
+        return;
+    }
+
+    unsigned num_chunks = (count + chunk - 1) / chunk;
+    for (unsigned i = 0; i < num_threads; ++i) {
+        queues[i].next.store(num_chunks * i / num_threads);
+        queues[i].end = num_chunks * (i + 1) / num_threads;
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        this->job = &body;
+        this->count = count;
+        this->chunk = chunk;
+        busy = num_threads - 1;
+        ++job_id;
+    }
+    start_signal.notify_all();
+
+    run(0);
+
+    unique_lock<mutex> guard(lock);
+    done_signal.wait(guard, [this] { return busy == 0; });
+    job = nullptr;
+}
+
+void ThreadPool::worker_loop(unsigned id) {
+    unsigned seen = 0;
+    while (true) {
+        {
+            unique_lock<mutex> guard(lock);
+            start_signal.wait(guard, [this, seen] { return stopping || job_id != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = job_id;
+        }
+
+        run(id);
+
+        {
+            lock_guard<mutex> guard(lock);
+            --busy;
+        }
+        done_signal.notify_one();
+    }
+}
+
+void ThreadPool::run(unsigned id) {
+    for (unsigned offset = 0; offset < num_threads; ++offset) {
+        Queue & queue = queues[(id + offset) % num_threads];
+        unsigned c;
+        while ((c = queue.next.fetch_add(1)) < queue.end) {
+            unsigned begin = c * chunk;
+            unsigned end = begin + chunk < count ? begin + chunk : count;
+            (*job)(begin, end);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#ifndef __THREAD_POOL_HPP__
+#define __THREAD_POOL_HPP__
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// A fixed set of worker threads that run parallel loops.
+//
+// parallel_for splits [0, count) into chunks and gives every thread (the calling
+// thread included) its own contiguous run of chunks. A thread that finishes its
+// own run steals the remaining chunks of the others, so a run full of dead
+// paddles doesn't leave its thread idle while another one is still busy.
+class ThreadPool {
+private:
+    struct alignas(64) Queue { //one cache line each, so owners and thieves don't false share
+        atomic<unsigned> next;
+        unsigned end;
+    };
+
+    vector<thread> workers;
+    unique_ptr<Queue[]> queues;
+    unsigned num_threads;
+
+    mutex lock;
+    condition_variable start_signal;
+    condition_variable done_signal;
+    unsigned job_id;
+    unsigned busy;
+    bool stopping;
+
+    const function<void(unsigned, unsigned)>* job;
+    unsigned count;
+    unsigned chunk;
+
+public:
+    //threads includes the thread that calls parallel_for, 0 uses every core
+    ThreadPool(unsigned threads = 0);
+    ~ThreadPool();
+
+    unsigned size() {
+        return num_threads;
+    }
+
+    //calls body(begin, end) for chunk sized pieces of [0, count) and returns once all of them are done.
+    //a piece always starts at a multiple of chunk
+    void parallel_for(unsigned count, unsigned chunk, const function<void(unsigned, unsigned)> & body);
+
+private:
+    void worker_loop(unsigned id);
+
+    //drains this thread's own queue first, then steals from the others
+    void run(unsigned id);
+};
+
+#endif
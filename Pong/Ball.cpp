@@ -0,0 +1,31 @@
+#include "Ball.hpp"
+
+Ball::Ball() {
+    speed = BALL_SPEED;
+    rect.x=0;
+    rect.y=0;
+    rect.h=16;
+    rect.w=16;
+    color.r = 255;
+    color.g = 255;
+    color.b = 255;
+    color.a = 255;
+}
+
+Ball::Ball(double x, double y) {
+    speed = BALL_SPEED;
+    rect.x=x;
+    rect.y=y;
+    rect.h=16;
+    rect.w=16;
+    color.r = 255;
+    color.g = 255;
+    color.b = 255;
+    color.a = 255;
+}
+
+void Ball::show(SDL_Renderer* renderer) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(renderer, &rect);
+    // SDL_RenderPresent(renderer);
+}
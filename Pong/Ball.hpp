@@ -2,7 +2,7 @@
 #define __BALL_H__
 
 
-#include "../sdl2lib/include/SDL2/SDL.h"
+#include "SDL2/SDL.h"
 #include "Object.hpp"
 #include "../definitions.hpp"
 
@@ -14,28 +14,8 @@ class Ball : public Object {
         SDL_Rect rect;
         SDL_Color color;
     public:
-        Ball() {
-            speed = BALL_SPEED;
-            rect.x=0;
-            rect.y=0;
-            rect.h=16;
-            rect.w=16;
-            color.r = 255;
-            color.g = 255;
-            color.b = 255;
-            color.a = 255;
-        }
-        Ball(double x, double y) {
-            speed = BALL_SPEED;
-            rect.x=x;
-            rect.y=y;
-            rect.h=16;
-            rect.w=16;
-            color.r = 255;
-            color.g = 255;
-            color.b = 255;
-            color.a = 255;
-        }
+        Ball();
+        Ball(double x, double y);
         double getH(){
             return rect.h;
         }
@@ -84,11 +64,7 @@ class Ball : public Object {
             color.b = new_color.b;
             color.a = new_color.a;
         }
-        void show(SDL_Renderer* renderer){
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-            SDL_RenderFillRect(renderer, &rect);
-            // SDL_RenderPresent(renderer);
-        }
+        void show(SDL_Renderer* renderer);
         SDL_Rect getRect(){
             return rect;
         }
@@ -1,7 +1,7 @@
 #ifndef __OBJECT_H__
 #define __OBJECT_H__
 
-#include "../sdl2lib/include/SDL2/SDL.h"
+#include "SDL2/SDL.h"
 #include <vector>
 
 class Object {
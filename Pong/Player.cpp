@@ -0,0 +1,36 @@
+#include "Player.hpp"
+
+void Player::get_input() {
+    controller->move(this);
+}
+
+Player::Player(Controller* controller, double x, double y, double h, double w) {
+    color.r = 255;
+    color.g = 255;
+    color.b = 255;
+    color.a = 255;
+    this->controller = controller;
+    rect.x=x;
+    rect.y=y;
+    rect.h=h;
+    rect.w=w;
+
+    fitness = 0;
+    previousY = rect.y;
+}
+
+Player::~Player() {
+    delete controller;
+}
+
+void Player::show(SDL_Renderer* renderer) {
+    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRect(renderer, &rect);
+    // SDL_RenderPresent(renderer);
+}
+
+void Player::randomize_color(Random & rng) {
+    color.r = rng.uniform(0,255);
+    color.g = rng.uniform(0,255);
+    color.b = rng.uniform(0,255);
+}
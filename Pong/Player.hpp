@@ -2,9 +2,10 @@
 #define __PLAYER_H__
 
 #include <iostream>
-#include "../sdl2lib/include/SDL2/SDL.h"
+#include "SDL2/SDL.h"
 #include "Object.hpp"
 #include "Controller.hpp"
+#include "../NeuralNetwork/Random.hpp"
 
 class Player : public Object {
     private:
@@ -15,26 +16,9 @@ class Player : public Object {
         unsigned fitness;
         unsigned previousY;
     public:
-        void get_input() {
-            controller->move(this);
-        }
-        Player(Controller* controller, double x, double y, double h, double w) {
-            color.r = 255;
-            color.g = 255;
-            color.b = 255;
-            color.a = 255;
-            this->controller = controller;
-            rect.x=x;
-            rect.y=y;
-            rect.h=h;
-            rect.w=w;
-
-            fitness = 0;
-            previousY = rect.y;
-        }
-        ~Player() {
-            delete controller;
-        }
+        void get_input();
+        Player(Controller* controller, double x, double y, double h, double w);
+        ~Player();
 
         double get_previousY() {
             return previousY;
@@ -76,28 +60,14 @@ class Player : public Object {
         void setW(double w){
             rect.w=w;
         }
-        void show(SDL_Renderer* renderer){
-            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
-            SDL_RenderFillRect(renderer, &rect);
-            // SDL_RenderPresent(renderer);
-        }
-        void randomize_color() {
-            color.r = fRand(0,255);
-            color.g = fRand(0,255);
-            color.b = fRand(0,255);
-        }
+        void show(SDL_Renderer* renderer);
+        void randomize_color(Random & rng = Random::local());
         SDL_Color get_color() {
             return color;
         }
         SDL_Rect getRect(){
             return rect;
         }
-    private:
-        float fRand(float fMin, float fMax) {
-            float f = (float)rand() / RAND_MAX;
-            return fMin + f * (fMax - fMin);
-        }
-
 };
 
 #endif
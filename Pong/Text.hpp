@@ -1,8 +1,8 @@
 #ifndef __TEXT_HPP__
 #define __TEXT_HPP__
 
-#include "../sdl2lib/include/SDL2/SDL.h"
-#include "../sdl2lib/include/SDL2/SDL_ttf.h"
+#include "SDL2/SDL.h"
+#include "SDL2/SDL_ttf.h"
 #include "Object.hpp"
 #include <iostream>
 #include <string>
@@ -39,76 +39,16 @@ class Text : public Object {
         };
 
         // destructor
-        ~Text() {
-            SDL_DestroyTexture(text_texture);
-            TTF_CloseFont(text_font);
-            text_texture = nullptr;
-            text_font = nullptr;
-        }
+        ~Text();
 
         // public functions
-        void create(SDL_Renderer* renderer) {
-            // open font
-            text_font = TTF_OpenFontIndex(font, size, 0); // change last argument if font has different font faces
-            if (text_font == nullptr) {
-                throw "Could not open font";
-                return;
-            }
-
-            // create rect that will contain text
-            set_text_rect_wh(text_rect.w, text_rect.h);
-
-            // create text_surface, and text_texture for surface
-            text_surface = TTF_RenderText_Solid(text_font, words, color);
-            if (text_surface == nullptr) {
-                throw "Could not create text surface";
-                return;
-            }
-
-            text_texture = SDL_CreateTextureFromSurface(renderer, text_surface);
-            if (text_texture == nullptr) {
-                throw "Could not create text texture from text surface";
-                return;
-            }
-
-            SDL_FreeSurface(text_surface); // done creating texture from surface -> can free surface immediately
-            text_surface = nullptr;
-
-            return;
-        }
-        void show(SDL_Renderer* renderer) {
-            // display text
-            SDL_RenderCopy(renderer, text_texture, NULL, &text_rect);
-            // SDL_RenderPresent(renderer);
-
-            return;
-        }
+        void create(SDL_Renderer* renderer);
+        void show(SDL_Renderer* renderer);
 
         // setters
-        void set_text_color(int r, int g, int b) {
-            if (r > -1 && g > -1 && b > -1 && r < 256 && g < 256 && b < 256) {
-                color = {(uint8_t)r, (uint8_t)g, (uint8_t)b, 255}; // default opacity = 255 = full
-            }
-            else
-                throw "Invalid rbg values";
-            return;
-        }
-        void set_text_size(double size) {
-            if (size > 0)
-                this->size = size;
-            else
-                throw "Invalid size";
-            return;
-        }
-        void set_text_pos(int pos_x, int pos_y) {
-            if (pos_x > -1 && pos_y > -1) {
-                text_rect.x = pos_x;
-                text_rect.y = pos_y;
-            }
-            else
-                throw "Invalid position";
-            return;
-        }
+        void set_text_color(int r, int g, int b);
+        void set_text_size(double size);
+        void set_text_pos(int pos_x, int pos_y);
 
         // getters
         string get_words() { return string(words); }
@@ -122,23 +62,7 @@ class Text : public Object {
     // private functions
     private:
         // set width, height and position of text_rect according to length and size of text and window
-        void set_text_rect_wh(int &width, int &height) { // text_rect.w and text_rect.h
-            int text_w = 0;
-            int text_h = 0;
-
-            if ((TTF_SizeText(text_font, words, &text_w, &text_h) != -1)) { // get and store the string's width and height to w and h
-                // do nothing. just need text_w and text_h to be passed in values
-            }
-            else {
-                cout << "Failed loading width and height of text";
-                return;
-            }
-            // set width and height of text_rect based on size of text
-            width = text_w;
-            height = text_h;
-
-            return;
-        }
+        void set_text_rect_wh(int &width, int &height);
 };
 
 #endif //__TEXT_HPP__
@@ -0,0 +1,120 @@
+#include "World.hpp"
+
+#include <cmath>
+
+using namespace std;
+
+World::World(unsigned size, int paddle_h, int paddle_w, float ball_speed, float paddle_speed):
+paddle_x(32), paddle_w(paddle_w), paddle_h(paddle_h), ball_speed(ball_speed), paddle_speed(paddle_speed), num_pairs(size) {
+    ball_x.resize(size);
+    ball_y.resize(size);
+    ball_vel_x.resize(size);
+    ball_vel_y.resize(size);
+    paddle_y.resize(size);
+    previous_y.resize(size);
+    fitness.resize(size);
+    movement.resize(size);
+    alive.resize(size);
+    reset();
+}
+
+void World::reset() {
+    for (unsigned i = 0; i < num_pairs; ++i) {
+        reset(i);
+    }
+}
+
+void World::reset(unsigned i) {
+    ball_x[i] = 0;
+    ball_y[i] = 0;
+    ball_vel_x[i] = 0;
+    ball_vel_y[i] = 0;
+    paddle_y[i] = (HEIGHT/2)-(HEIGHT/8);
+    previous_y[i] = paddle_y[i];
+    fitness[i] = 0;
+    movement[i] = 0;
+    alive[i] = 1;
+}
+
+void World::serve() {
+    paddle_x = WIDTH-32;
+    for (unsigned i = 0; i < num_pairs; ++i) {
+        serve(i);
+    }
+}
+
+void World::serve(unsigned i) {
+    ball_x[i] = paddle_x-(paddle_w*4 + 200);
+    ball_vel_x[i] = ball_speed/-2;
+    ball_vel_y[i] = 0;
+    ball_y[i] = (HEIGHT/2)-8;
+}
+
+unsigned World::num_movements(unsigned i) {
+    unsigned total = 0;
+    for (unsigned action = UP; action <= STAY; ++action) {
+        if (movement[i] & (1 << action)) {
+            ++total;
+        }
+    }
+    return total;
+}
+
+void World::bounce_off_wall(int x, int y, int w, int h, unsigned begin, unsigned end, Random & rng) {
+    for (unsigned i = begin; i < end; ++i) {
+        if (alive[i] && intersects(ball_x[i], ball_y[i], BALL_SIZE, BALL_SIZE, x, y, w, h)) {
+            double num = rng.below(360);
+            ball_vel_x[i] = ball_speed*fabs(cos(num));
+            ball_vel_y[i] = ball_speed*sin(num);
+        }
+    }
+    move_balls(begin, end);
+}
+
+unsigned World::step(unsigned begin, unsigned end, unsigned* died) {
+    for (unsigned i = begin; i < end; ++i) {
+        if (alive[i] && intersects(ball_x[i], ball_y[i], BALL_SIZE, BALL_SIZE, paddle_x, paddle_y[i], paddle_w, paddle_h)) {
+            //sends ball at different angle based on where the ball has hit the paddle
+            double rel = (paddle_y[i]+(paddle_h/2.0))-(ball_y[i]+8);
+            double norm = rel/(paddle_h/2.0);
+            double bounce = norm * (5*PI/12);
+            ball_vel_x[i] = (ball_speed*-1)*cos(bounce);
+            ball_vel_y[i] = ball_speed*-sin(bounce);
+            if (paddle_y[i] != previous_y[i]) {
+                ++fitness[i];
+            }
+            previous_y[i] = paddle_y[i];
+        }
+    }
+
+    move_balls(begin, end);
+
+    for (unsigned i = begin; i < end; ++i) { // boundaries for paddles
+        int y = paddle_y[i];
+        y = y < 0 ? 0 : y;
+        y = y + paddle_h > HEIGHT ? HEIGHT - paddle_h : y;
+        paddle_y[i] = y;
+    }
+
+    unsigned num_died = 0;
+    for (unsigned i = begin; i < end; ++i) {
+        if (alive[i] && ball_x[i]+BALL_SIZE >= WIDTH) {
+            alive[i] = 0;
+            ball_vel_x[i] = 0; //dead balls stay where they are
+            ball_vel_y[i] = 0;
+            died[num_died++] = i;
+        }
+    }
+    return num_died;
+}
+
+void World::move_balls(unsigned begin, unsigned end) {
+    for (unsigned i = begin; i < end; ++i) {
+        float vel_y = ball_vel_y[i];
+        bool wall = ball_y[i] <= 0 || ball_y[i]+BALL_SIZE >= HEIGHT;
+        vel_y = wall ? -vel_y : vel_y;
+        ball_vel_y[i] = vel_y;
+        ball_x[i] = (int)(ball_vel_x[i] + ball_x[i]);
+        ball_y[i] = (int)(vel_y + ball_y[i]);
+    }
+}
@@ -0,0 +1,95 @@
+#ifndef __WORLD_HPP__
+#define __WORLD_HPP__
+
+#include "../definitions.hpp"
+#include "../NeuralNetwork/Random.hpp"
+
+#include <vector>
+
+using namespace std;
+
+// The state of every paddle/ball pair of a training generation, stored as
+// structure of arrays: pair i is ball_x[i], ball_y[i], paddle_y[i], ...
+//
+// It follows the same rules as Ball/Player in Play (int positions like SDL_Rect,
+// the same bounce angles, walls and boundaries), but stepping a slice of pairs is
+// a few passes over contiguous arrays instead of a getter call per object.
+class World {
+public:
+    static const int BALL_SIZE = 16;
+
+    enum Action { UP = 0, DOWN = 1, STAY = 2 };
+
+    vector<int> ball_x;
+    vector<int> ball_y;
+    vector<float> ball_vel_x;
+    vector<float> ball_vel_y;
+
+    vector<int> paddle_y;
+    vector<int> previous_y;
+    vector<unsigned> fitness;         //hits returned while the paddle was moving
+    vector<unsigned char> movement;   //bit per Action the paddle has taken
+    vector<unsigned char> alive;
+
+    int paddle_x;
+    int paddle_w;
+    int paddle_h;
+    float ball_speed;
+    float paddle_speed;
+
+private:
+    unsigned num_pairs;
+
+public:
+    World(unsigned size, int paddle_h, int paddle_w, float ball_speed, float paddle_speed);
+
+    //a fresh generation: every pair alive, paddles centered, balls not served yet
+    void reset();
+
+    void reset(unsigned i);
+
+    //puts the paddles on the right wall and sends every ball towards them
+    void serve();
+
+    void serve(unsigned i);
+
+    void move_paddle(unsigned i, Action action) {
+        if (action == UP) {
+            paddle_y[i] = paddle_y[i] - paddle_speed;
+        }
+        else if (action == DOWN) {
+            paddle_y[i] = paddle_y[i] + paddle_speed;
+        }
+        movement[i] |= 1 << action;
+    }
+
+    //number of different actions the paddle has taken
+    unsigned num_movements(unsigned i);
+
+    //Train's left wall: balls that touch it are sent back at a random angle, then every ball moves
+    void bounce_off_wall(int x, int y, int w, int h, unsigned begin, unsigned end, Random & rng);
+
+    //returns the bounce off each pair's paddle, moves the balls, keeps the paddles on screen and
+    //finds the balls that got past their paddle. Those pairs are marked dead and their indices are
+    //written to died, which needs room for end - begin entries. returns how many died
+    unsigned step(unsigned begin, unsigned end, unsigned* died);
+
+    unsigned size() {
+        return num_pairs;
+    }
+
+private:
+    //top and bottom walls, then ball movement
+    void move_balls(unsigned begin, unsigned end);
+
+    //same test as SDL_HasIntersection
+    static bool intersects(int ax, int ay, int aw, int ah, int bx, int by, int bw, int bh) {
+        int left = ax > bx ? ax : bx;
+        int right = ax + aw < bx + bw ? ax + aw : bx + bw;
+        int top = ay > by ? ay : by;
+        int bottom = ay + ah < by + bh ? ay + ah : by + bh;
+        return left < right && top < bottom;
+    }
+};
+
+#endif
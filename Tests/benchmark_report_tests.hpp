@@ -0,0 +1,123 @@
+#ifndef __BENCHMARK_REPORT_TESTS_H__
+#define __BENCHMARK_REPORT_TESTS_H__
+
+#include <iostream>
+#include <sstream>
+#include "tests.hpp"
+#include "../BenchmarkReport.hpp"
+
+// The benchmark's CSV report, read back field by field as a spreadsheet would.
+class BenchmarkReportTests : public Tests {
+    public:
+        virtual void run_tests() {
+            csv_field_count_test();
+            csv_round_trip_test();
+
+            std::cout << "-------------------\n";
+            SetColor(2);
+            std::cout << "Passed " << passed << " tests\n";
+            SetColor(4);
+            std::cout << "Failed " << failed << " tests\n";
+            SetColor(7);
+            std::cout << "-------------------\n";
+
+            return;
+        }
+
+        //splits one CSV line into its fields, quoted fields may hold commas and doubled quotes
+        static vector<string> split_row(const string & line) {
+            vector<string> fields(1);
+            bool quoted = false;
+            for (unsigned i = 0; i < line.size(); ++i) {
+                char c = line[i];
+                if (quoted && c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                    fields.back() += '"';
+                    ++i;
+                }
+                else if (c == '"') {
+                    quoted = !quoted;
+                }
+                else if (c == ',' && !quoted) {
+                    fields.push_back("");
+                }
+                else {
+                    fields.back() += c;
+                }
+            }
+            return fields;
+        }
+
+        //labels like the ones the benchmark writes, some with commas and quotes in them
+        static vector<Result> sample_results() {
+            vector<Result> results;
+            results.push_back({"forward", "flat 6-6-3", 1.5e6, "passes/s"});
+            results.push_back({"islands", "1200 paddles, 4 islands", 21.5, "generations/s"});
+            results.push_back({"decision", "1200 paddles, every 4 frames", 30.25, "generations/s"});
+            results.push_back({"quoted", "the \"fast\" path, again", 2, "x"});
+            return results;
+        }
+
+        void csv_field_count_test() {
+            vector<Result> results = sample_results();
+            stringstream csv(to_csv(results));
+            string line;
+            getline(csv, line);
+            unsigned header = split_row(line).size();
+            unsigned rows = 0;
+            unsigned bad_rows = 0;
+            string bad_line;
+            while (getline(csv, line)) {
+                ++rows;
+                if (split_row(line).size() != header) {
+                    ++bad_rows;
+                    bad_line = line;
+                }
+            }
+
+            if (header != 4 || rows != results.size() || bad_rows != 0) {
+                failed++;
+                std::cout << "[FAILED] To_CSV: Rows do not have as many fields as the header\n"
+                          << "       Expected: " << results.size() << " rows of 4 fields\n"
+                          << "       Actual: a header of " << header << " fields, " << rows << " rows, " << bad_rows
+                          << " of them wrong, e.g. " << bad_line << "\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] To_CSV: Every row has as many fields as the header" << std::endl;
+            }
+
+            std::cout << std::endl;
+            return;
+        }
+
+        void csv_round_trip_test() {
+            vector<Result> results = sample_results();
+            stringstream csv(to_csv(results));
+            string line;
+            getline(csv, line);
+            unsigned mismatches = 0;
+            string expected, actual;
+            for (unsigned i = 0; i < results.size() && getline(csv, line); ++i) {
+                vector<string> fields = split_row(line);
+                if (fields.size() != 4 || fields[0] != results[i].benchmark || fields[1] != results[i].config || fields[3] != results[i].unit) {
+                    ++mismatches;
+                    expected = results[i].config;
+                    actual = fields.size() > 1 ? fields[1] : line;
+                }
+            }
+
+            if (mismatches != 0) {
+                failed++;
+                std::cout << "[FAILED] To_CSV: Labels do not read back as they were written\n"
+                          << "       Expected: " << expected << "\n"
+                          << "       Actual: " << actual << "\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] To_CSV: Labels with commas and quotes read back as they were written" << std::endl;
+            }
+
+            std::cout << std::endl;
+            return;
+        }
+};
+
+#endif
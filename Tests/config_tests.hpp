@@ -0,0 +1,134 @@
+#ifndef __CONFIG_TESTS_H__
+#define __CONFIG_TESTS_H__
+
+#include "../config.hpp"
+#include "../NeuralNetwork/NetworkHandler.hpp"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include "tests.hpp"
+
+class ConfigTests : public Tests {
+    private:
+
+    public:
+        virtual void run_tests() {
+            defaults_test();
+            parse_test();
+            bad_option_test();
+            load_test();
+            handler_test();
+
+            std::cout << "-------------------\n";
+            SetColor(2);
+            std::cout << "Passed " << passed << " tests\n";
+            SetColor(4);
+            std::cout << "Failed " << failed << " tests\n";
+            SetColor(7);
+            std::cout << "-------------------\n";
+
+            return;
+        }
+
+        void defaults_test() {
+            Config config;
+            if (config.topology.inputs != INPUTS || config.topology.hidden_layer_size != HIDDEN_LAYER_SIZE ||
+                config.population != POPULATION || config.mutation_rate != MUTATION_RATE ||
+                config.num_fittest != NUM_FITTEST || config.ball_speed != BALL_SPEED || config.height_ratio != HEIGHT_RATIO) {
+                failed++;
+                std::cout << "[FAILED] Config(): does not start from the defaults in definitions.hpp\n";
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] Config(): starts from the defaults in definitions.hpp\n";
+            }
+        }
+
+        void parse_test() {
+            const char* argv[] = {"trainer", "5", "--population", "64", "ck", "--mutation_rate", "0.1", "--hidden_layer_size", "8", "--seed", "7"};
+            Config config;
+            vector<string> args;
+            bool parsed = config.parse(11, (char**)argv, args);
+            if (!parsed || config.population != 64 || config.mutation_rate != 0.1f || config.topology.hidden_layer_size != 8 ||
+                config.seed != 7 || args.size() != 2 || args.at(0) != "5" || args.at(1) != "ck") {
+                failed++;
+                std::cout << "[FAILED] parse(): Failed to apply the flags\n"
+                          << "       Expected: population 64, mutation rate 0.1, hidden layer size 8, seed 7 and 2 arguments left\n"
+                          << "       Actual: population " << config.population << ", mutation rate " << config.mutation_rate
+                          << ", hidden layer size " << config.topology.hidden_layer_size << ", seed " << config.seed
+                          << " and " << args.size() << " arguments left\n";
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] parse(): flags are applied and the other arguments are kept\n";
+            }
+        }
+
+        void bad_option_test() {
+            Config config;
+            const char* argv[] = {"trainer", "--popluation", "64"};
+            vector<string> args;
+            if (config.set("population", "0") || config.set("population", "-5") || config.set("mutation_rate", "2") ||
+                config.set("inputs", "9") || config.set("ball_speed", "fast") || config.set("no_such_option", "1") ||
+                config.set("decision_interval", "0") ||
+                config.parse(3, (char**)argv, args) || config.population != POPULATION) {
+                failed++;
+                std::cout << "[FAILED] set(): accepted an unknown option or a value that doesn't fit it\n";
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] set(): unknown options and bad values are rejected\n";
+            }
+        }
+
+        void load_test() {
+            Config saved;
+            saved.set("num_fittest", "7");
+            saved.set("paddle_speed", "12.5");
+            saved.set("evaluation_frames", "5000");
+            string path = "config_test.cfg";
+            {
+                ofstream out(path);
+                out << "# a sweep\n" << saved.to_string() << "\n";
+            }
+            Config loaded;
+            bool read = loaded.load(path);
+            remove(path.c_str());
+            if (!read || loaded.to_string() != saved.to_string()) {
+                failed++;
+                std::cout << "[FAILED] load(): Failed to read back to_string()\n"
+                          << "       Expected:\n" << saved.to_string()
+                          << "       Actual:\n" << loaded.to_string();
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] load(): to_string() is read back unchanged\n";
+            }
+        }
+
+        void handler_test() {
+            Config config;
+            config.set("population", "70");
+            config.set("height_ratio", "4");
+            config.set("num_rendered", "2");
+            config.set("seed", "11");
+            NetworkHandler* handler = new NetworkHandler(config);
+            handler->init_networks();
+            if (handler->size() != 70 || handler->get_world().paddle_h != HEIGHT / 4 ||
+                handler->get_rendered_indices().size() != 2 || handler->get_seed() != 11) {
+                failed++;
+                std::cout << "[FAILED] NetworkHandler(Config): does not follow the config\n"
+                          << "       Expected: 70 pairs, paddles " << HEIGHT / 4 << " tall, 2 rendered and seed 11\n"
+                          << "       Actual: " << handler->size() << " pairs, paddles " << handler->get_world().paddle_h
+                          << " tall, " << handler->get_rendered_indices().size() << " rendered and seed " << handler->get_seed() << "\n";
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] NetworkHandler(Config): population, paddle size, rendering and seed follow the config\n";
+            }
+            delete handler;
+        }
+};
+
+
+#endif
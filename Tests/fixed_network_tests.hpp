@@ -0,0 +1,92 @@
+#ifndef __FIXED_NETWORK_TESTS_H__
+#define __FIXED_NETWORK_TESTS_H__
+
+#include "../NeuralNetwork/FixedNetwork.hpp"
+#include "../NeuralNetwork/NeuralNetwork.hpp"
+#include <iostream>
+#include <cmath>
+#include "tests.hpp"
+
+class FixedNetworkTests : public Tests {
+    private:
+
+    public:
+        virtual void run_tests() {
+            genome_size_test();
+            forward_propagation_test();
+            fixed_forward_for_test();
+
+            std::cout << "-------------------\n";
+            SetColor(2);
+            std::cout << "Passed " << passed << " tests\n";
+            SetColor(4);
+            std::cout << "Failed " << failed << " tests\n";
+            SetColor(7);
+            std::cout << "-------------------\n";
+
+            return;
+        }
+
+        void genome_size_test() {
+            NetworkParams params(4,3,1,5);
+            NeuralNetwork nn(params);
+            if (FixedNetwork4315::GENOME_SIZE != nn.genome_size()) {
+                failed++;
+                std::cout << "[FAILED] GENOME_SIZE: does not match NeuralNetwork\n"
+                          << "       Expected: " << nn.genome_size() << "\n"
+                          << "       Actual: " << FixedNetwork4315::GENOME_SIZE << "\n";
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] GENOME_SIZE: " << FixedNetwork4315::GENOME_SIZE << " matches NeuralNetwork\n";
+            }
+            std::cout << std::endl;
+        }
+
+        void forward_propagation_test() {
+            NetworkParams params(3,3,1,5);
+            NeuralNetwork nn(params);
+            FixedNetwork3315 fixed(nn);
+
+            bool same = true;
+            for (unsigned trial = 0; trial < 100; ++trial) {
+                for (unsigned i = 0; i < 3; ++i) {
+                    float input = (float)rand() / RAND_MAX;
+                    nn.get_inputs()[i] = input;
+                    fixed.get_inputs()[i] = input;
+                }
+                nn.forward_propagation();
+                fixed.forward_propagation();
+                for (unsigned i = 0; i < 3; ++i) {
+                    if (std::fabs(nn.get_outputs()[i] - fixed.get_outputs()[i]) > 1e-5f) {
+                        same = false;
+                    }
+                }
+            }
+
+            if (!same) {
+                failed++;
+                std::cout << "[FAILED] forward_propagation(): outputs differ from NeuralNetwork\n";
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] forward_propagation(): outputs match NeuralNetwork\n";
+            }
+            std::cout << std::endl;
+        }
+
+        void fixed_forward_for_test() {
+            if (fixed_forward_for(NetworkParams(4,3,1,5)) == nullptr || fixed_forward_for(NetworkParams(10,3,3,7)) != nullptr) {
+                failed++;
+                std::cout << "[FAILED] fixed_forward_for(): wrong kernel selected\n"
+                          << "       Expected: a kernel for 4_3_1_5 and none for 10_3_3_7\n";
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] fixed_forward_for(): kernel only selected for compiled topologies\n";
+            }
+            std::cout << std::endl;
+        }
+};
+
+#endif
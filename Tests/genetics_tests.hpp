@@ -0,0 +1,121 @@
+#ifndef __GENETICS_TESTS_H__
+#define __GENETICS_TESTS_H__
+
+#include <iostream>
+#include "tests.hpp"
+#include "../NeuralNetwork/Genetics.hpp"
+#include <cstring>
+#include <vector>
+
+class GeneticsTests : public Tests {
+    public:
+        virtual void run_tests() {
+            crossover_test();
+            mutate_test();
+            simd_test(Matrix::SSE2, "SSE2");
+            simd_test(Matrix::AVX2, "AVX2");
+
+            std::cout << "-------------------\n";
+            SetColor(2);
+            std::cout << "Passed " << passed << " tests\n";
+            SetColor(4);
+            std::cout << "Failed " << failed << " tests\n";
+            SetColor(7);
+            std::cout << "-------------------\n";
+
+            return;
+        }
+
+        // every gene comes from one of the parents, about half from each
+        void crossover_test() {
+            const unsigned length = 6403;
+            std::vector<float> a(length, 1), b(length, 2), child(length, 0);
+            Random rng(3);
+            Genetics::crossover(a.data(), b.data(), child.data(), length, rng);
+            unsigned from_a = 0, from_b = 0;
+            for (unsigned i = 0; i < length; ++i) {
+                from_a += child[i] == 1;
+                from_b += child[i] == 2;
+            }
+            report(from_a + from_b == length && from_a > length * 0.45 && from_a < length * 0.55, "crossover",
+                   "every gene comes from a parent, half of them from each");
+
+            Random again(3);
+            std::vector<float> same(length, 0);
+            Genetics::crossover(a.data(), b.data(), same.data(), length, again);
+            report(same == child, "crossover", "the same seed gives the same child");
+
+            std::cout << std::endl;
+        }
+
+        // about mutation_rate of the genes change, by less than 1 each
+        void mutate_test() {
+            const unsigned length = 100000;
+            std::vector<float> genome(length, 0);
+            Random rng(5);
+            Genetics::mutate(genome.data(), length, 0.05, rng);
+            unsigned mutated = 0;
+            bool in_range = true;
+            for (unsigned i = 0; i < length; ++i) {
+                mutated += genome[i] != 0;
+                in_range = in_range && genome[i] >= -1 && genome[i] < 1;
+            }
+            report(in_range && mutated > length * 0.045 && mutated < length * 0.055, "mutate",
+                   "about 5% of the genes are mutated at a rate of 0.05");
+
+            std::vector<float> none(length, 0), all(length, 0);
+            Genetics::mutate(none.data(), length, 0, rng);
+            Genetics::mutate(all.data(), length, 1, rng);
+            unsigned all_mutated = 0;
+            for (unsigned i = 0; i < length; ++i) {
+                all_mutated += all[i] != 0;
+            }
+            report(none == std::vector<float>(length, 0) && all_mutated > length * 0.99, "mutate",
+                   "a rate of 0 changes nothing and a rate of 1 changes every gene");
+
+            std::cout << std::endl;
+        }
+
+        // the blend kernels are compared against the scalar reference path, bit for bit
+        void simd_test(Matrix::SimdLevel level, const char* name) {
+            if (Matrix::detected_simd_level() < level) {
+                std::cout << "[SKIPPED] " << name << ": not supported by this cpu\n" << std::endl;
+                return;
+            }
+
+            // an odd length so every kernel also runs its scalar tail
+            const unsigned length = 203;
+            std::vector<float> a(length), b(length), expected(length), actual(length);
+            Random fill(7);
+            for (unsigned i = 0; i < length; ++i) {
+                a[i] = fill.uniform(-1, 1);
+                b[i] = fill.uniform(-1, 1);
+            }
+            a[0] = -0.0f;
+
+            Random rng(9);
+            Matrix::set_simd_level(Matrix::SCALAR);
+            Genetics::crossover(a.data(), b.data(), expected.data(), length, rng);
+            rng.seed(9);
+            Matrix::set_simd_level(level);
+            Genetics::crossover(a.data(), b.data(), actual.data(), length, rng);
+            Matrix::set_simd_level(Matrix::detected_simd_level());
+            report(memcmp(expected.data(), actual.data(), length * sizeof(float)) == 0, name, "crossover matches the scalar kernel bit for bit");
+
+            std::cout << std::endl;
+        }
+
+    private:
+        void report(bool ok, const char* name, const char* what) {
+            if (ok) {
+                passed++;
+                std::cout << "[PASSED] " << name << ": " << what << "\n";
+            }
+            else {
+                failed++;
+                std::cout << "[FAILED] " << name << ": " << what << "\n";
+            }
+        }
+};
+
+#endif
@@ -0,0 +1,85 @@
+#ifndef __INTERCEPT_TESTS_H__
+#define __INTERCEPT_TESTS_H__
+
+#include <iostream>
+#include <cmath>
+#include "tests.hpp"
+#include "../NeuralNetwork/Sensor.hpp"
+#include "../NeuralNetwork/Random.hpp"
+
+// Sensor::intercept_y against the frame by frame loop it replaces, on states that
+// don't need a Ball (see SensorTests for the ones read from a Ball).
+class InterceptTests : public Tests {
+    public:
+        virtual void run_tests() {
+            random_states_test();
+
+            std::cout << "-------------------\n";
+            SetColor(2);
+            std::cout << "Passed " << passed << " tests\n";
+            SetColor(4);
+            std::cout << "Failed " << failed << " tests\n";
+            SetColor(7);
+            std::cout << "-------------------\n";
+
+            return;
+        }
+
+        // dense random in-play states, weighted towards the cases where float rounding decides the
+        // answer: frame counts that land right on player_x, balls right at a wall and shallow angles
+        void random_states_test() {
+            const unsigned samples = 400000;
+            Random rng(12345);
+            unsigned mismatches = 0;
+            double worst = 0;
+            Sensor::State worst_state = {};
+            for (unsigned k = 0; k < samples; ++k) {
+                Sensor::State state = {};
+                state.player_x = WIDTH - 32;
+                double angle = rng.uniform(-1.3, 1.3);
+                if (k % 4 == 0) {
+                    angle *= 0.001;
+                }
+                double speed = k % 3 == 0 ? BALL_SPEED : rng.uniform(1, 30);
+                state.ball_vel_x = speed * fabs(cos(angle));
+                state.ball_vel_y = speed * sin(angle);
+                state.ball_x = rng.uniform(0, state.player_x);
+                if (k % 5 == 0) { //a whole number of frames away, as the loop adds them up
+                    state.ball_x = state.player_x - (double)(float)state.ball_vel_x * rng.below(100);
+                }
+                state.ball_y = rng.uniform(-10, HEIGHT + 10);
+                if (k % 7 == 0) { //within float rounding of a wall
+                    state.ball_y = rng.below(2) ? HEIGHT - rng.uniform(0, 1e-4) : rng.uniform(0, 1e-4);
+                }
+                if (!(state.ball_x < state.player_x)) {
+                    continue;
+                }
+
+                double difference = fabs(Sensor::intercept_y(state) - Sensor::step_intercept_y(state));
+                if (difference > 0.1) {
+                    ++mismatches;
+                }
+                if (difference > worst) {
+                    worst = difference;
+                    worst_state = state;
+                }
+            }
+
+            if (mismatches != 0) {
+                failed++;
+                std::cout << "[FAILED] Intercept_Y: Closed form does not match the frame by frame prediction\n"
+                          << "       Expected: every prediction within 0.1 pixels\n"
+                          << "       Actual: " << mismatches << " predictions differ, by up to " << worst << " pixels, e.g. ball ("
+                          << worst_state.ball_x << ", " << worst_state.ball_y << ") moving (" << worst_state.ball_vel_x << ", "
+                          << worst_state.ball_vel_y << ")\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Intercept_Y: Closed form matches the frame by frame prediction on " << samples << " random states" << std::endl;
+            }
+
+            std::cout << std::endl;
+            return;
+        }
+};
+
+#endif
@@ -0,0 +1,180 @@
+#ifndef __ISLAND_MODEL_TESTS_H__
+#define __ISLAND_MODEL_TESTS_H__
+
+#include <fstream>
+#include <iostream>
+#include <vector>
+#include "tests.hpp"
+#include "../NeuralNetwork/IslandModel.hpp"
+
+class IslandModelTests : public Tests {
+    private:
+        Config small_config(unsigned islands) {
+            Config config;
+            config.population = 101;
+            config.islands = islands;
+            config.migration_interval = 1;
+            config.migrants = 2;
+            config.seed = 42;
+            return config;
+        }
+
+    public:
+        virtual void run_tests() {
+            split_test();
+            single_island_test();
+            migrate_test();
+            steady_generation_test();
+            deterministic_test();
+
+            std::cout << "-------------------\n";
+            SetColor(2);
+            std::cout << "Passed " << passed << " tests\n";
+            SetColor(4);
+            std::cout << "Failed " << failed << " tests\n";
+            SetColor(7);
+            std::cout << "-------------------\n";
+
+            return;
+        }
+
+        void split_test() {
+            IslandModel model(small_config(4));
+            unsigned total = 0;
+            for (unsigned i = 0; i < model.size(); ++i) {
+                total += model.island(i).size();
+            }
+            if (model.size() != 4 || total != 101 || model.island(0).size() != 26 || model.island(3).size() != 25 ||
+                model.island(0).get_seed() != 42 || model.island(1).get_seed() == model.island(2).get_seed()) {
+                failed++;
+                std::cout << "[FAILED] IslandModel(): Failed to split the population\n"
+                          << "       Expected: 4 islands of 26, 25, 25 and 25 networks with their own seeds\n"
+                          << "       Actual: " << model.size() << " islands, " << total << " networks\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] IslandModel(): the population is split between islands with their own seeds" << std::endl;
+            }
+        }
+
+        void single_island_test() {
+            Config config = small_config(1);
+            IslandModel model(config);
+            NetworkHandler handler(config);
+            model.init_networks();
+            handler.init_networks();
+            model.serve();
+            handler.serve();
+            vector<float> fittest = model.evaluate(32, 0, 22, HEIGHT, 5000);
+            handler.evaluate(32, 0, 22, HEIGHT, 5000);
+
+            bool same = fittest.size() == 1 && model.island(0).size() == handler.size();
+            for (unsigned i = 0; same && i < handler.size(); ++i) {
+                if (!(*model.island(0).networks[i] == *handler.networks[i])) {
+                    same = false;
+                }
+            }
+            if (!same) {
+                failed++;
+                std::cout << "[FAILED] Evaluate: one island doesn't breed what a NetworkHandler breeds\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Evaluate: one island breeds the same generation as a NetworkHandler" << std::endl;
+            }
+        }
+
+        void migrate_test() {
+            IslandModel model(small_config(3));
+            model.init_networks();
+            model.serve();
+            model.evaluate(32, 0, 22, HEIGHT, 5000); //migrates, since the interval is 1
+
+            //the fittest networks of island 0 are now the last networks of island 1
+            vector<float> genomes;
+            vector<float> fitness;
+            model.island(0).emigrants(2, genomes, fitness);
+            NetworkHandler & next = model.island(1);
+            unsigned length = next.networks[0]->genome_size();
+            bool moved = genomes.size() == 2 * length;
+            for (unsigned k = 0; moved && k < 2; ++k) {
+                const float* genome = next.networks[next.size() - 1 - k]->get_genome();
+                for (unsigned j = 0; j < length; ++j) {
+                    if (genome[j] != genomes[k * length + j]) {
+                        moved = false;
+                        break;
+                    }
+                }
+            }
+            if (!moved) {
+                failed++;
+                std::cout << "[FAILED] Migrate: the fittest networks of an island did not reach the next island\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Migrate: the fittest networks of an island replace the last networks of the next one" << std::endl;
+            }
+        }
+
+        //in steady state every island counts its own generations, the model's count goes up once per evaluate
+        //and checkpoints follow it
+        void steady_generation_test() {
+            const char* path = "island_generation_test.tmp";
+            Config config = small_config(3);
+            config.steady_state = true;
+            IslandModel model(config);
+            model.init_networks();
+            model.set_checkpoint(path, 2);
+            model.serve();
+            unsigned first = model.get_nth_generation();
+            bool counted = true;
+            for (unsigned g = 1; counted && g <= 3; ++g) {
+                model.evaluate(32, 0, 22, HEIGHT, 5000);
+                model.island(2).wait_for_checkpoint();
+                bool written = ifstream(model.checkpoint_path_of(path, 2)).is_open();
+                remove(model.checkpoint_path_of(path, 2).c_str());
+                counted = model.get_nth_generation() == first + g && written == ((first + g) % 2 == 0);
+            }
+            if (!counted) {
+                failed++;
+                std::cout << "[FAILED] Evaluate: the model's generation or checkpoints didn't follow its evaluations\n"
+                          << "       Expected: generation " << first + 3 << ", checkpoints every 2 generations\n"
+                          << "       Actual: generation " << model.get_nth_generation() << "\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Evaluate: steady state islands advance and checkpoint one model generation at a time" << std::endl;
+            }
+            for (unsigned i = 0; i < model.size(); ++i) {
+                model.island(i).wait_for_checkpoint();
+                remove(model.checkpoint_path_of(path, i).c_str());
+            }
+        }
+
+        void deterministic_test() {
+            IslandModel first(small_config(3));
+            IslandModel second(small_config(3));
+            first.init_networks();
+            second.init_networks();
+            first.serve();
+            second.serve();
+            bool same = true;
+            for (unsigned g = 0; g < 3; ++g) {
+                same = same && first.evaluate(32, 0, 22, HEIGHT, 5000) == second.evaluate(32, 0, 22, HEIGHT, 5000);
+            }
+            for (unsigned i = 0; same && i < first.size(); ++i) {
+                for (unsigned j = 0; j < first.island(i).size(); ++j) {
+                    if (!(*first.island(i).networks[j] == *second.island(i).networks[j])) {
+                        same = false;
+                        break;
+                    }
+                }
+            }
+            if (!same) {
+                failed++;
+                std::cout << "[FAILED] Evaluate: two runs with the same seed evolved differently\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Evaluate: islands evolve the same way for the same seed" << std::endl;
+            }
+            std::cout << std::endl;
+        }
+};
+
+#endif
@@ -4,6 +4,10 @@
 #include <iostream>
 #include "tests.hpp"
 #include "../NeuralNetwork/Matrix.h"
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
 
 class MatrixTests : public Tests {
     private:
@@ -18,6 +22,9 @@ class MatrixTests : public Tests {
         // }
         virtual void run_tests() {
             ReLU_test();
+            multiply_into_test();
+            simd_test(Matrix::SSE2, "SSE2");
+            simd_test(Matrix::AVX2, "AVX2");
 
             std::cout << "-------------------\n";
             SetColor(2);
@@ -74,6 +81,97 @@ class MatrixTests : public Tests {
             return;
         }
 
+        void multiply_into_test() {
+            // 1 2 3   10
+            // 4 5 6   20
+            //         30
+            float arr[6] = {1, 2, 3, 4, 5, 6};
+            float arr2[3] = {10, 20, 30};
+            float solution[2] = {-1, -1};
+            m.multiply_into(arr, arr2, solution, 2, 3);
+            if (solution[0] != 140 || solution[1] != 320) {
+                failed++;
+                std::cout << "[FAILED] multiply_into: Failed to return correct value\n"
+                     << "       Expected: 140 320 is returned\n"
+                     << "       Actual: " << solution[0] << ' ' << solution[1] << " is returned\n";
+
+            } else {
+                passed++;
+                std::cout << "[PASSED] multiply_into: " << solution[0] << ' ' << solution[1] << " is correctly returned\n";
+            }
+
+            std::cout << std::endl;
+            return;
+        }
+
+        // the vector kernels are compared against the scalar reference path
+        void simd_test(Matrix::SimdLevel level, const char* name) {
+            if (Matrix::detected_simd_level() < level) {
+                std::cout << "[SKIPPED] " << name << ": not supported by this cpu\n" << std::endl;
+                return;
+            }
+
+            // odd sizes so every kernel also runs its scalar tail
+            const unsigned rows = 5, cols = 11, batch = 37;
+            std::vector<float> arr(rows * cols * batch), arr2(cols * batch), bias(rows * batch);
+            for (unsigned i = 0; i < arr.size(); ++i) arr[i] = (float)rand() / RAND_MAX * 2 - 1;
+            for (unsigned i = 0; i < arr2.size(); ++i) arr2[i] = (float)rand() / RAND_MAX * 2 - 1;
+            for (unsigned i = 0; i < bias.size(); ++i) bias[i] = (float)rand() / RAND_MAX * 2 - 1;
+            bias[0] = -0.0f;
+
+            // matvec sums in a different order, so only tolerance-level agreement is expected
+            std::vector<float> expected(rows), actual(rows);
+            Matrix::multiply_into_scalar(arr.data(), arr2.data(), expected.data(), rows, cols);
+            Matrix::set_simd_level(level);
+            m.multiply_into(arr.data(), arr2.data(), actual.data(), rows, cols);
+            Matrix::set_simd_level(Matrix::detected_simd_level());
+            report(close(expected, actual), name, "multiply_into matches the scalar kernel within 1e-5");
+
+            // the batched kernel sums every member in the same order as the scalar kernel
+            expected.assign(rows * batch, 0);
+            actual.assign(rows * batch, 0);
+            Matrix::batched_multiply_into_scalar(arr.data(), arr2.data(), expected.data(), rows, cols, batch, batch);
+            Matrix::set_simd_level(level);
+            m.batched_multiply_into(arr.data(), arr2.data(), actual.data(), rows, cols, batch);
+            Matrix::set_simd_level(Matrix::detected_simd_level());
+            report(close(expected, actual), name, "batched_multiply_into matches the scalar kernel within 1e-5");
+
+            // bias_ReLU has to agree bit for bit
+            std::vector<float> activations(rows * batch);
+            activations[0] = -0.0f;
+            for (unsigned i = 1; i < activations.size(); ++i) activations[i] = (float)rand() / RAND_MAX * 2 - 1;
+            expected = activations;
+            actual = activations;
+            Matrix::bias_ReLU_scalar(expected.data(), bias.data(), rows * batch);
+            Matrix::set_simd_level(level);
+            m.bias_ReLU(actual.data(), bias.data(), rows * batch);
+            Matrix::set_simd_level(Matrix::detected_simd_level());
+            report(memcmp(expected.data(), actual.data(), expected.size() * sizeof(float)) == 0, name, "bias_ReLU matches the scalar kernel bit for bit");
+
+            std::cout << std::endl;
+            return;
+        }
+
+    private:
+        bool close(const std::vector<float> & expected, const std::vector<float> & actual) {
+            for (unsigned i = 0; i < expected.size(); ++i) {
+                if (std::fabs(expected[i] - actual[i]) > 1e-5f * (1 + std::fabs(expected[i]))) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void report(bool ok, const char* name, const char* what) {
+            if (!ok) {
+                failed++;
+                std::cout << "[FAILED] " << name << ": " << what << " is not true\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] " << name << ": " << what << "\n";
+            }
+        }
+
 };
 
 #endif
\ No newline at end of file
@@ -4,7 +4,6 @@
 #include <iostream>
 #include <vector>
 #include "tests.hpp"
-#include "../Pong/Object.hpp"
 #include "../NeuralNetwork/NetworkHandler.hpp"
 
 class NHTests : public Tests {
@@ -14,8 +13,16 @@ class NHTests : public Tests {
     public:
         virtual void run_tests() {
             init_networks_test();
-            getBalls_test();
+            get_world_test();
+            serve_test();
             size_test();
+            checkpoint_test();
+            checkpoint_header_test();
+            elite_pool_test();
+            evaluate_test();
+            breed_threads_test();
+            steady_state_test();
+            decision_interval_test();
 
             std::cout << "-------------------\n";
             SetColor(2);
@@ -31,7 +38,7 @@ class NHTests : public Tests {
         }
 
         void init_networks_test() { 
-            int i_num_gen = nh->num_generations;
+            unsigned i_num_gen = nh->num_generations;
 
             nh->init_networks();
 
@@ -45,37 +52,40 @@ class NHTests : public Tests {
                 std::cout << "[PASSED] Init_Networks: Generation size is 3 as expected" << std::endl;
             }
 
-            bool is_ball_emp = 0;
-            bool is_player_emp = 0;
+            bool is_network_emp = 0;
             for (unsigned i = 0; i < nh->generation_size; ++i) {
-                if (nh->balls[i] == nullptr) {
-                    is_ball_emp = 1;
-                    break;
-                }
-                if (nh->players[i] == nullptr) {
-                    is_player_emp = 1;
+                if (nh->networks[i] == nullptr) {
+                    is_network_emp = 1;
                     break;
                 }
             }
 
-            if (is_ball_emp == 1) {
+            if (is_network_emp == 1) {
                 failed++;
-                std::cout << "[FAILED] Init_Networks: Failed to init balls\n"
-                          << "       Expected: generation_size number of balls are created\n"
-                          << "       Actual: some ball pointers are still null\n";
+                std::cout << "[FAILED] Init_Networks: Failed to init networks\n"
+                          << "       Expected: generation_size number of networks are created\n"
+                          << "       Actual: some network pointers are still null\n";
             } else {
                 passed++;
-                std::cout << "[PASSED] Init_Networks: All balls are initialized" << std::endl;
+                std::cout << "[PASSED] Init_Networks: All networks are initialized" << std::endl;
+            }
+
+            bool is_pair_dead = 0;
+            for (unsigned i = 0; i < nh->generation_size; ++i) {
+                if (!nh->world.alive[i]) {
+                    is_pair_dead = 1;
+                    break;
+                }
             }
 
-            if (is_player_emp == 1) {
+            if (nh->world.size() != 3 || is_pair_dead == 1) {
                 failed++;
-                std::cout << "[FAILED] Init_Networks: Failed to init players\n"
-                          << "       Expected: generation_size number of players are created\n"
-                          << "       Actual: some ball pointers are still null\n";
+                std::cout << "[FAILED] Init_Networks: Failed to init world\n"
+                          << "       Expected: generation_size paddle/ball pairs that are all alive\n"
+                          << "       Actual: world.size() == " << nh->world.size() << "\n";
             } else {
                 passed++;
-                std::cout << "[PASSED] Init_Networks: All players are initialized" << std::endl;
+                std::cout << "[PASSED] Init_Networks: All paddle/ball pairs are initialized" << std::endl;
             }
 
             if ((i_num_gen + 1) != nh->num_generations) {
@@ -93,19 +103,336 @@ class NHTests : public Tests {
             return;
         }
 
-        void getBalls_test() {
-            Ball** balls = nullptr;
-            balls = nh->getBalls();
+        void get_world_test() {
+            World & world = nh->get_world();
+
+            if (&world != &nh->world || world.size() != nh->size()) {
+                failed++;
+                std::cout << "[FAILED] Get_World: Failed to get the world\n"
+                          << "       Expected: one paddle/ball pair per network\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Get_World: Successfully get the world" << std::endl;
+            }
+
+            std::cout << std::endl;
+            return;
+        }
+
+        void serve_test() {
+            nh->serve();
+            World & world = nh->get_world();
+
+            bool served = world.paddle_x == WIDTH-32;
+            for (unsigned i = 0; i < world.size(); ++i) {
+                if (world.ball_vel_x[i] >= 0 || world.ball_x[i] >= world.paddle_x) {
+                    served = false;
+                }
+            }
+
+            if (!served) {
+                failed++;
+                std::cout << "[FAILED] Serve: Balls were not served\n"
+                          << "       Expected: paddles on the right wall and every ball heading towards them\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Serve: Every ball is served" << std::endl;
+            }
+
+            std::cout << std::endl;
+            return;
+        }
+
+        void checkpoint_test() {
+            const char* path = "nh_checkpoint_test.tmp";
+            nh->set_seed(1234);
+            nh->checkpoint(path);
+            nh->wait_for_checkpoint();
+
+            NetworkHandler* resumed = new NetworkHandler(3, 3, 1, 5, 0.05, 3);
+            bool loaded = resumed->resume(path);
+
+            bool same = loaded && resumed->num_generations == nh->num_generations && resumed->get_seed() == 1234;
+            for (unsigned i = 0; same && i < nh->generation_size; ++i) {
+                if (!(*resumed->networks[i] == *nh->networks[i])) {
+                    same = false;
+                }
+            }
+
+            if (!same) {
+                failed++;
+                std::cout << "[FAILED] Checkpoint: Failed to resume from a checkpoint\n"
+                          << "       Expected: the same networks, generation and seed\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Checkpoint: Successfully resumed from a checkpoint" << std::endl;
+            }
+
+            delete resumed;
+            remove(path);
+            std::cout << std::endl;
+            return;
+        }
+
+        //a header whose genome length doesn't follow from its topology, with the sizes and checksum made to
+        //add up, is turned away before anything is sized from it
+        void checkpoint_header_test() {
+            const char* path = "nh_checkpoint_header_test.tmp";
+            nh->checkpoint(path);
+            nh->wait_for_checkpoint();
+
+            Checkpoint state;
+            state.read(path);
+            state.genome_length *= state.generation_size;
+            state.generation_size = 1;
+            state.best_genomes.clear();
+            state.best_fitness.clear();
+            CheckpointWriter::write_atomic(path, state.serialize());
+
+            bool rejected = false;
+            try {
+                Checkpoint corrupted;
+                corrupted.read(path);
+            }
+            catch (const char*) {
+                rejected = true;
+            }
+
+            if (!rejected) {
+                failed++;
+                std::cout << "[FAILED] Checkpoint: Read a checkpoint whose genome length doesn't match its topology\n"
+                          << "       Expected: the file to be rejected\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Checkpoint: A checkpoint whose genome length doesn't match its topology is rejected" << std::endl;
+            }
+
+            remove(path);
+            std::cout << std::endl;
+            return;
+        }
+
+        void elite_pool_test() {
+            NetworkParams params(3, 3, 1, 5);
+            ElitePool pool(2);
+            NeuralNetwork* weak = new NeuralNetwork(params);
+            NeuralNetwork* strong = new NeuralNetwork(params);
+            NeuralNetwork* copy = new NeuralNetwork(strong, params);
+            NeuralNetwork* best = new NeuralNetwork(params);
+
+            bool kept = pool.offer(weak, 1) == nullptr && pool.offer(strong, 5) == nullptr;
+            bool copy_kept = pool.offer(copy, 8) != copy; //same genome as strong, only raises its fitness
+            NeuralNetwork* evicted = pool.offer(best, 3); //full, replaces weak
+
+            vector<pair<NeuralNetwork*, float>> members = pool.sorted();
+            if (!kept || copy_kept || evicted != weak || members.size() != 2 ||
+                members.at(0).first != strong || members.at(0).second != 8 || members.at(1).first != best) {
+                failed++;
+                std::cout << "[FAILED] Elite_Pool: Failed to keep the fittest distinct networks\n"
+                          << "       Expected: strong with fitness 8, then best\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Elite_Pool: Keeps the fittest distinct networks" << std::endl;
+            }
 
-            if (balls == nullptr) {
+            delete copy;
+            delete evicted;
+            std::cout << std::endl;
+            return;
+        }
+
+        void evaluate_test() {
+            NetworkHandler* stepped = new NetworkHandler(3, 3, 1, 5, 0.05, 100);
+            NetworkHandler* evaluated = new NetworkHandler(3, 3, 1, 5, 0.05, 100);
+            stepped->set_seed(42);
+            evaluated->set_seed(42);
+            stepped->init_networks();
+            evaluated->init_networks();
+            stepped->serve();
+            evaluated->serve();
+
+            unsigned frames = 0;
+            while (stepped->get_nth_generation() == 1 && frames < 100000) {
+                stepped->bounce_off_wall(32, 0, 22, HEIGHT);
+                stepped->update();
+                ++frames;
+            }
+            vector<float> fitness = evaluated->evaluate(32, 0, 22, HEIGHT, 100000);
+
+            bool same = stepped->get_nth_generation() == 2 && evaluated->get_nth_generation() == 2 && fitness.size() == 100;
+            for (unsigned i = 0; same && i < 100; ++i) {
+                if (!(*stepped->networks[i] == *evaluated->networks[i])) {
+                    same = false;
+                }
+            }
+
+            if (!same) {
+                failed++;
+                std::cout << "[FAILED] Evaluate: Fast forwarding a generation changed the result\n"
+                          << "       Expected: the same next generation as stepping frame by frame\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Evaluate: Fast forwarding breeds the same generation as stepping" << std::endl;
+            }
+
+            delete stepped;
+            delete evaluated;
+            std::cout << std::endl;
+            return;
+        }
+
+        void breed_threads_test() {
+            Config config;
+            config.population = 300;
+            config.seed = 42;
+            config.threads = 1;
+            NetworkHandler* single = new NetworkHandler(config);
+            config.threads = 4;
+            NetworkHandler* threaded = new NetworkHandler(config);
+            single->init_networks();
+            threaded->init_networks();
+            single->serve();
+            threaded->serve();
+            for (unsigned g = 0; g < 2; ++g) {
+                single->evaluate(32, 0, 22, HEIGHT, 20000);
+                threaded->evaluate(32, 0, 22, HEIGHT, 20000);
+            }
+
+            bool same = single->get_nth_generation() == 3 && threaded->get_nth_generation() == 3;
+            for (unsigned i = 0; same && i < 300; ++i) {
+                if (!(*single->networks[i] == *threaded->networks[i])) {
+                    same = false;
+                }
+            }
+
+            if (!same) {
+                failed++;
+                std::cout << "[FAILED] Breed: the next generation depends on the number of threads\n"
+                          << "       Expected: the same generations bred on 1 and 4 threads\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Breed: 1 and 4 threads breed the same generations" << std::endl;
+            }
+
+            delete single;
+            delete threaded;
+            std::cout << std::endl;
+            return;
+        }
+
+        void steady_state_test() {
+            Config config;
+            config.population = 200;
+            config.seed = 42;
+            config.steady_state = true;
+            NetworkHandler* first = new NetworkHandler(config);
+            NetworkHandler* second = new NetworkHandler(config);
+            first->init_networks();
+            second->init_networks();
+            first->serve();
+            second->serve();
+
+            //every death is refilled on the spot, so nobody is ever left out of the game
+            bool refilled = true;
+            for (unsigned f = 0; f < 2000; ++f) {
+                first->bounce_off_wall(32, 0, 22, HEIGHT);
+                first->update();
+                second->bounce_off_wall(32, 0, 22, HEIGHT);
+                second->update();
+                for (unsigned i = 0; refilled && i < 200; ++i) {
+                    refilled = first->world.alive[i] && first->networks[i] != nullptr;
+                }
+            }
+            refilled = refilled && first->num_alive == 200 && first->births > 0;
+            if (!refilled) {
+                failed++;
+                std::cout << "[FAILED] Steady State: a dead pair's slot was left empty\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Steady State: dead pairs are replaced by a new child right away" << std::endl;
+            }
+
+            vector<float> fitness = first->evaluate(32, 0, 22, HEIGHT, 20000);
+            bool same = fitness == second->evaluate(32, 0, 22, HEIGHT, 20000) && fitness.size() == 200 &&
+                        first->get_nth_generation() >= 2 && first->births >= 200 && first->births == second->births;
+            for (unsigned i = 0; same && i < 200; ++i) {
+                if (!(*first->networks[i] == *second->networks[i])) {
+                    same = false;
+                }
+            }
+            if (!same) {
+                failed++;
+                std::cout << "[FAILED] Steady State: two runs with the same seed evolved differently\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Steady State: a generation is a population's worth of births, the same for the same seed" << std::endl;
+            }
+
+            delete first;
+            delete second;
+            std::cout << std::endl;
+            return;
+        }
+
+        void decision_interval_test() {
+            Config config;
+            config.population = 100;
+            config.seed = 42;
+            config.decision_interval = 3;
+            NetworkHandler* handler = new NetworkHandler(config);
+            handler->init_networks();
+            handler->serve();
+
+            //moves only change on frames 1, 4, 7, ... of the generation
+            bool repeated = true;
+            vector<unsigned char> last = handler->actions;
+            for (unsigned f = 1; f <= 300 && handler->get_nth_generation() == 1; ++f) {
+                handler->bounce_off_wall(32, 0, 22, HEIGHT);
+                handler->update();
+                if ((f - 1) % 3 != 0 && handler->actions != last) {
+                    repeated = false;
+                }
+                last = handler->actions;
+            }
+            if (!repeated) {
+                failed++;
+                std::cout << "[FAILED] Decision Interval: a network decided in between decisions\n"
+                          << "       Expected: every move is repeated for 3 frames\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Decision Interval: networks decide every 3 frames and repeat their move in between" << std::endl;
+            }
+
+            //evaluate() plays the same games as update()
+            config.population = 150;
+            NetworkHandler* stepped = new NetworkHandler(config);
+            NetworkHandler* evaluated = new NetworkHandler(config);
+            stepped->init_networks();
+            evaluated->init_networks();
+            stepped->serve();
+            evaluated->serve();
+            for (unsigned f = 0; f < 20000 && stepped->get_nth_generation() == 1; ++f) {
+                stepped->bounce_off_wall(32, 0, 22, HEIGHT);
+                stepped->update();
+            }
+            evaluated->evaluate(32, 0, 22, HEIGHT, 20000);
+            bool same = stepped->get_nth_generation() == 2 && evaluated->get_nth_generation() == 2;
+            for (unsigned i = 0; same && i < 150; ++i) {
+                if (!(*stepped->networks[i] == *evaluated->networks[i])) {
+                    same = false;
+                }
+            }
+            if (!same) {
                 failed++;
-                std::cout << "[FAILED] Get_Balls_Pointers: Failed to balls pointers\n"
-                          << "       Expected: balls pointer is not null\n";
+                std::cout << "[FAILED] Decision Interval: evaluate() and update() bred different generations\n";
             } else {
                 passed++;
-                std::cout << "[PASSED] Get_Balls_Pointers: Successfully get balls pointers" << std::endl;
+                std::cout << "[PASSED] Decision Interval: evaluate() breeds the generation update() breeds" << std::endl;
             }
 
+            delete handler;
+            delete stepped;
+            delete evaluated;
             std::cout << std::endl;
             return;
         }
@@ -114,7 +441,7 @@ class NHTests : public Tests {
             unsigned size = -1;
             size = nh->size();
 
-            if (size == -1) {
+            if (size == (unsigned)-1) {
                 failed++;
                 std::cout << "[FAILED] Get_Size: Failed to get generation size\n"
                           << "       Expected: size is not -1\n";
@@ -131,7 +458,7 @@ class NHTests : public Tests {
             unsigned gen = -1;
             gen = nh->get_nth_generation();
 
-            if (gen == -1) {
+            if (gen == (unsigned)-1) {
                 failed++;
                 std::cout << "[FAILED] Get_nth_Generation: Failed to get num generation\n"
                           << "       Expected: gen is not -1\n";
@@ -3,6 +3,7 @@
 
 #include "../NeuralNetwork/NeuralNetwork.hpp"
 #include <iostream>
+#include <type_traits>
 #include "tests.hpp"
 
 class NeuralNetworkTests : public Tests {
@@ -11,6 +12,9 @@ class NeuralNetworkTests : public Tests {
     public:
         virtual void run_tests() {
             constructor();
+            genome_test();
+            copy_on_write_test();
+            binary_save_test();
             
             std::cout << "-------------------\n";
             SetColor(2);
@@ -49,6 +53,142 @@ class NeuralNetworkTests : public Tests {
             }
             delete test;
          }
+
+         void genome_test() {
+            NetworkParams params(3,3,1,5);
+            NeuralNetwork* original = new NeuralNetwork(params);
+            NeuralNetwork* copy = new NeuralNetwork(original, params);
+
+            // 3+5+3 biases and 5*3+3*5 weights
+            if (original->genome_size() != 41) {
+                std::cout << "[FAILED] genome_size(): Failed to return correct value\n"
+                      << "       Expected: 41 is returned\n"
+                      << "       Actual: " << original->genome_size() << " is returned\n";
+                failed++;
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] genome_size(): " << original->genome_size() << " is correctly returned\n";
+            }
+
+            if (!(*copy == *original) || copy->get_genome() != original->get_genome() || original->genome_use_count() != 2) {
+                std::cout << "[FAILED] copy constructor: Failed to copy the genome\n"
+                      << "       Expected: an equal genome, sharing the original's block\n";
+                failed++;
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] copy constructor: genome is correctly shared\n";
+            }
+
+            //the views may point into a shared genome, so not even a mutable network hands out writable ones
+            static_assert(std::is_same<decltype(original->get_weights()), const float* const* const*>::value &&
+                          std::is_same<decltype(original->get_biases()), const float* const*>::value,
+                          "get_weights() and get_biases() have to be read only");
+            if (original->get_weights()[0][0] != original->get_genome() + 11) {
+                std::cout << "[FAILED] get_weights(): weights are not a view into the genome\n"
+                      << "       Expected: the first weight follows the 11 biases\n";
+                failed++;
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] get_weights(): weights are a view into the genome\n";
+            }
+            delete original;
+            delete copy;
+         }
+
+         // a shared genome is copied only once one of the networks changes its genes
+         void copy_on_write_test() {
+            NetworkParams params(3,3,1,5);
+            Random rng(11);
+            NeuralNetwork* original = new NeuralNetwork(params, rng);
+            NeuralNetwork* copy = new NeuralNetwork(params, rng);
+            copy->share(original);
+            std::vector<float> genes(original->get_genome(), original->get_genome() + original->genome_size());
+            uint64_t hash = original->hash();
+
+            copy->breed(copy, copy, 1, rng); //mutates every gene of its own genome
+            bool ok = copy->get_genome() != original->get_genome() && !(*copy == *original) &&
+                      original->genome_use_count() == 1 && copy->genome_use_count() == 1 &&
+                      std::vector<float>(original->get_genome(), original->get_genome() + original->genome_size()) == genes &&
+                      original->hash() == hash && copy->get_weights()[0][0] == copy->get_genome() + 11;
+
+            copy->share(original);
+            copy->set_genome(genes.data());
+            ok = ok && *copy == *original && copy->get_genome() != original->get_genome() && copy->hash() == hash;
+
+            if (!ok) {
+                std::cout << "[FAILED] share(): changing a shared genome changed the other network\n"
+                      << "       Expected: the changed network gets its own block, the other keeps its genes\n";
+                failed++;
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] share(): a shared genome is copied on write\n";
+            }
+            delete copy;
+            delete original;
+         }
+
+         void binary_save_test() {
+            NetworkParams params(3,3,1,5);
+            NeuralNetwork* original = new NeuralNetwork(params);
+            string file_name = original->save("", 42, 7);
+
+            if (!GenomeFile::is_binary(file_name)) {
+                std::cout << "[FAILED] save(): Failed to write a binary genome file\n";
+                failed++;
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] save(): " << file_name << " is a binary genome file\n";
+            }
+
+            GenomeFile::Header header;
+            vector<float> genomes;
+            vector<float> fitness;
+            GenomeFile::read(file_name, header, genomes, fitness);
+            NeuralNetwork* loaded = new NeuralNetwork(file_name);
+            if (!(*loaded == *original) || header.generation != 7 || fitness.at(0) != 42) {
+                std::cout << "[FAILED] NeuralNetwork(string): Failed to load the binary genome file\n"
+                      << "       Expected: the same genome, generation 7 and fitness 42\n"
+                      << "       Actual: generation " << header.generation << " and fitness " << fitness.at(0) << "\n";
+                failed++;
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] NeuralNetwork(string): binary genome file is correctly loaded\n";
+            }
+
+            //a header whose topology doesn't give its genome length is turned away before anything is allocated
+            GenomeFile::Header bad = original->header(0);
+            bad.hidden_layers = 0;
+            vector<const float*> bad_genomes(1, original->get_genome());
+            vector<float> bad_fitness(1, 0);
+            string bad_name = file_name + ".bad";
+            GenomeFile::write(bad_name, bad, bad_genomes, bad_fitness);
+            bool rejected = false;
+            try {
+                NeuralNetwork mismatched(bad_name);
+            }
+            catch (const char*) {
+                rejected = true;
+            }
+            if (!rejected) {
+                std::cout << "[FAILED] NeuralNetwork(string): loaded a genome file that doesn't match its topology\n";
+                failed++;
+            }
+            else {
+                passed++;
+                std::cout << "[PASSED] NeuralNetwork(string): a genome file that doesn't match its topology is rejected\n";
+            }
+
+            remove(bad_name.c_str());
+            remove(file_name.c_str());
+            delete original;
+            delete loaded;
+         }
 };
 
 
@@ -3,7 +3,7 @@
 
 #include <iostream>
 #include "tests.hpp"
-#include "../GameMode/Play.hpp"
+#include "../Gamemode/Play.hpp"
 
 class PlayTests : public Tests {
     private: 
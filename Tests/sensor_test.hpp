@@ -2,10 +2,12 @@
 #define __SENSORTESTS_H__
 
 #include <iostream>
+#include <cmath>
 #include "tests.hpp"
 #include "../NeuralNetwork/Sensor.hpp"
+#include "../Pong/Ball.hpp"
 #include "../Pong/Player.hpp"
-#include "../Pong/USer.hpp"
+#include "../Pong/User.hpp"
 
 class SensorTests : public Tests {
     private:
@@ -14,6 +16,7 @@ class SensorTests : public Tests {
     public:
         virtual void run_tests() {
             set_activations_test();
+            intercept_test();
 
             std::cout << "-------------------\n";
             SetColor(2);
@@ -134,6 +137,46 @@ class SensorTests : public Tests {
             std::cout << std::endl;
             return;
         }
+
+        void intercept_test() {
+            const double xs[4] = {40, 300, 700, 1100};
+            const double ys[5] = {-5, 8, 360, 701, 725};
+            unsigned mismatches = 0;
+            double worst = 0;
+            for (unsigned i = 0; i < 4; ++i) {
+                for (unsigned j = 0; j < 5; ++j) {
+                    for (int angle = -75; angle <= 75; angle += 5) {
+                        Sensor::State state = {};
+                        state.ball_x = xs[i];
+                        state.ball_y = ys[j];
+                        state.ball_vel_x = BALL_SPEED * cos(angle * PI / 180);
+                        state.ball_vel_y = BALL_SPEED * sin(angle * PI / 180);
+                        state.player_x = WIDTH - 32;
+
+                        double difference = fabs(Sensor::intercept_y(state) - Sensor::step_intercept_y(state));
+                        if (difference > 0.01) {
+                            ++mismatches;
+                        }
+                        if (difference > worst) {
+                            worst = difference;
+                        }
+                    }
+                }
+            }
+
+            if (mismatches != 0) {
+                failed++;
+                std::cout << "[FAILED] Intercept_Y: Closed form does not match the frame by frame prediction\n"
+                          << "       Expected: every prediction within 0.01 pixels\n"
+                          << "       Actual: " << mismatches << " predictions differ, by up to " << worst << " pixels\n";
+            } else {
+                passed++;
+                std::cout << "[PASSED] Intercept_Y: Closed form matches the frame by frame prediction" << std::endl;
+            }
+
+            std::cout << std::endl;
+            return;
+        }
 };
 
 #endif
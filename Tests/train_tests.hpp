@@ -3,7 +3,7 @@
 
 #include <iostream>
 #include "tests.hpp"
-#include "../GameMode/Train.hpp"
+#include "../Gamemode/Train.hpp"
 
 class TrainTests : public Tests {
     private: 
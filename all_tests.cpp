@@ -1,6 +1,4 @@
-//g++ all_tests.cpp -Isdl2lib\include -Lsdl2lib\lib -w -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -o compile/test
-
-//g++ all_tests.cpp -ISDL2-mingw32\include -L SDL2-mingw32\lib -w -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -o compile/test
+//cmake --build build --target all_tests    (see Building in the README)
 
 #include "Tests/tests.hpp"
 #include "Tests/ball_tests.hpp"
@@ -14,6 +12,12 @@
 #include "Tests/sensor_test.hpp"
 #include "Tests/network_handler_tests.hpp"
 #include "Tests/neural_network_tests.hpp"
+#include "Tests/fixed_network_tests.hpp"
+#include "Tests/genetics_tests.hpp"
+#include "Tests/config_tests.hpp"
+#include "Tests/island_model_tests.hpp"
+#include "Tests/intercept_tests.hpp"
+#include "Tests/benchmark_report_tests.hpp"
 
 
 int main(int argc, char * argv[]) {
@@ -131,15 +135,73 @@ int main(int argc, char * argv[]) {
     delete test;
     cout << endl << "======================================================================================" << endl << endl;
 
+    SetColor(14);
+    cout << "Performing FixedNetwork Class Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new FixedNetworkTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing Genetics Class Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new GeneticsTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing Config Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new ConfigTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing IslandModel Class Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new IslandModelTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing Intercept Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new InterceptTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing Benchmark Report Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new BenchmarkReportTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
     SetColor(2);
     cout << "TOTAL PASSED: " << tot_passed << endl;
     SetColor(4);
     cout << "TOTAL FAILED: " << tot_failed << endl;
     SetColor(7);
 
-    system("PAUSE");
-
-    return 0;
+    return tot_failed == 0 ? 0 : 1;
 }
 
 //g++ all_tests.cpp -Isdl2lib\include -Lsdl2lib\lib -w -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -o compile/test
@@ -0,0 +1,381 @@
+//cmake --build build --target benchmark    (see Building in the README)
+
+// Measures training throughput so changes can be compared run to run.
+//
+//   benchmark [--csv] [--out file] [--seconds s] [--seed seed]
+//
+//   forward   forward passes/s of one network for the 3-3-1-5 and 4-3-1-5 topologies,
+//             as a NeuralNetwork, a FixedNetwork and one member of a BatchedNetwork
+//   step      frames/s and paddle steps/s of NetworkHandler::update for 100, 1200 and 10000 paddles
+//   evaluate  generations/s of NetworkHandler::evaluate for the same sizes
+//   islands   generations/s of IslandModel::evaluate for 1200 paddles on 1, 2, 4 and 8 islands
+//   steady    generations/s (population births/s) of steady state NetworkHandler::evaluate for 1200 paddles
+//   decision  paddle steps/s of NetworkHandler::update for 1200 paddles deciding every 1, 2, 4 and 8 frames,
+//             and the mean fittest network of the first 10 generations of the same seed at each interval
+//   breed     milliseconds to breed one generation, and children/s of the genetic operators alone
+//   save/load genomes/s and MB/s writing and reading a population genome file
+//
+// Results are JSON (one object per measurement) or CSV, on stdout or in --out.
+// The handlers' own console output is discarded while they are measured.
+
+#include "definitions.hpp"
+#include "BenchmarkReport.hpp"
+#include "NeuralNetwork/NeuralNetwork.hpp"
+#include "NeuralNetwork/FixedNetwork.hpp"
+#include "NeuralNetwork/BatchedNetwork.hpp"
+#include "NeuralNetwork/NetworkHandler.hpp"
+#include "NeuralNetwork/IslandModel.hpp"
+#include "NeuralNetwork/GenomeFile.hpp"
+#include "NeuralNetwork/Genetics.hpp"
+#include "NeuralNetwork/Random.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+class Benchmarks {
+private:
+    double seconds; //minimum time spent on each measurement
+    unsigned seed;
+    vector<Result> results;
+
+public:
+    Benchmarks(double seconds, unsigned seed): seconds(seconds), seed(seed) {}
+
+    void run() {
+        forward(NetworkParams(3, 3, 1, 5));
+        forward(NetworkParams(4, 3, 1, 5));
+        fixed_forward<3, 3, 1, 5>();
+        fixed_forward<4, 3, 1, 5>();
+
+        const unsigned sizes[3] = {100, 1200, 10000};
+        for (unsigned i = 0; i < 3; ++i) {
+            step(sizes[i]);
+            evaluate(sizes[i]);
+        }
+        const unsigned num_islands[4] = {1, 2, 4, 8};
+        for (unsigned i = 0; i < 4; ++i) {
+            islands(1200, num_islands[i]);
+        }
+        steady_state(1200);
+        const unsigned intervals[4] = {1, 2, 4, 8};
+        for (unsigned i = 0; i < 4; ++i) {
+            decision(1200, intervals[i]);
+        }
+        breed(1200);
+        genetics(41);
+        genetics(1000);
+        save_load(1200);
+    }
+
+    const vector<Result> & get_results() {
+        return results;
+    }
+
+private:
+    void add(string benchmark, string config, double value, string unit) {
+        results.push_back({benchmark, config, value, unit});
+        cerr << benchmark << ' ' << config << ": " << value << ' ' << unit << endl;
+    }
+
+    static string topology(NetworkParams params) {
+        return to_string(params.inputs) + "-" + to_string(params.outputs) + "-" + to_string(params.hidden_layers) + "-" + to_string(params.hidden_layer_size);
+    }
+
+    static double now() {
+        return chrono::duration<double>(chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    //calls body(reps) with growing reps until a call takes at least seconds, returns reps per second
+    template<typename F>
+    double rate(F body) {
+        unsigned long long reps = 1;
+        while (true) {
+            double start = now();
+            body(reps);
+            double elapsed = now() - start;
+            if (elapsed >= seconds) {
+                return reps / elapsed;
+            }
+            reps = elapsed <= 0 ? reps * 10 : reps * (seconds * 1.2 / elapsed) + 1;
+        }
+    }
+
+    void forward(NetworkParams params) {
+        Random rng(seed);
+        NeuralNetwork nn(params, rng);
+        float* inputs = nn.get_inputs();
+        volatile float sink = 0;
+        double passes = rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                inputs[r % params.inputs] = rng.uniform();
+                nn.forward_propagation();
+            }
+            sink = sink + nn.get_outputs()[0];
+        });
+        add("forward", topology(params) + " NeuralNetwork", passes, "passes/s");
+
+        const unsigned members = 1200;
+        BatchedNetwork batch(params, members);
+        for (unsigned i = 0; i < members; ++i) {
+            NeuralNetwork member(params, rng);
+            batch.load(i, &member);
+        }
+        double batches = rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                batch.forward_propagation();
+            }
+        });
+        add("forward", topology(params) + " BatchedNetwork", batches * members, "passes/s");
+    }
+
+    template<unsigned In, unsigned Out, unsigned Hidden, unsigned Width>
+    void fixed_forward() {
+        Random rng(seed);
+        NetworkParams params(In, Out, Hidden, Width);
+        NeuralNetwork nn(params, rng);
+        FixedNetwork<In, Out, Hidden, Width> fixed(nn);
+        float* inputs = fixed.get_inputs();
+        volatile float sink = 0;
+        double passes = rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                inputs[r % In] = rng.uniform();
+                fixed.forward_propagation();
+            }
+            sink = sink + fixed.get_outputs()[0];
+        });
+        add("forward", topology(params) + " FixedNetwork", passes, "passes/s");
+    }
+
+    NetworkHandler* new_handler(unsigned size) {
+        NetworkHandler* handler = new NetworkHandler(INPUTS, OUTPUTS, HIDDEN_LAYERS, HIDDEN_LAYER_SIZE, 0.05, size);
+        handler->set_seed(seed);
+        handler->init_networks();
+        handler->serve();
+        return handler;
+    }
+
+    void step(unsigned size) {
+        NetworkHandler* handler = new_handler(size);
+        unsigned long long paddle_steps = 0;
+        unsigned long long frames = 0;
+        double start = now();
+        rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                paddle_steps += handler->num_alive;
+                handler->bounce_off_wall(32, 0, 22, HEIGHT);
+                handler->update();
+            }
+            frames += reps;
+        });
+        double elapsed = now() - start;
+        add("step", to_string(size) + " paddles", frames / elapsed, "frames/s");
+        add("step", to_string(size) + " paddles", paddle_steps / elapsed, "paddle steps/s");
+        delete handler;
+    }
+
+    void evaluate(unsigned size) {
+        NetworkHandler* handler = new_handler(size);
+        double generations = rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                handler->evaluate(32, 0, 22, HEIGHT, 20000);
+            }
+        });
+        add("evaluate", to_string(size) + " paddles", generations, "generations/s");
+        delete handler;
+    }
+
+    void islands(unsigned size, unsigned num_islands) {
+        Config config;
+        config.population = size;
+        config.islands = num_islands;
+        config.seed = seed;
+        IslandModel* model = new IslandModel(config);
+        model->init_networks();
+        model->serve();
+        double generations = rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                model->evaluate(32, 0, 22, HEIGHT, 20000);
+            }
+        });
+        add("islands", to_string(size) + " paddles/" + to_string(num_islands) + " islands", generations, "generations/s");
+        delete model;
+    }
+
+    void steady_state(unsigned size) {
+        Config config;
+        config.population = size;
+        config.seed = seed;
+        config.steady_state = true;
+        NetworkHandler* handler = new NetworkHandler(config);
+        handler->init_networks();
+        handler->serve();
+        double generations = rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                handler->evaluate(32, 0, 22, HEIGHT, 20000);
+            }
+        });
+        add("steady", to_string(size) + " paddles", generations, "generations/s");
+        delete handler;
+    }
+
+    void decision(unsigned size, unsigned interval) {
+        Config config;
+        config.population = size;
+        config.seed = seed;
+        config.decision_interval = interval;
+        string name = to_string(size) + " paddles/every " + to_string(interval) + " frames";
+
+        NetworkHandler* handler = new NetworkHandler(config);
+        handler->init_networks();
+        handler->serve();
+        unsigned long long paddle_steps = 0;
+        double start = now();
+        rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                paddle_steps += handler->num_alive;
+                handler->bounce_off_wall(32, 0, 22, HEIGHT);
+                handler->update();
+            }
+        });
+        add("decision", name, paddle_steps / (now() - start), "paddle steps/s");
+        delete handler;
+
+        //a fixed number of generations, so every interval is compared after the same amount of evolution
+        const unsigned generations = 10;
+        handler = new NetworkHandler(config);
+        handler->init_networks();
+        handler->serve();
+        double fittest = 0;
+        for (unsigned g = 0; g < generations; ++g) {
+            vector<float> fitness = handler->evaluate(32, 0, 22, HEIGHT, 20000);
+            fittest += *max_element(fitness.begin(), fitness.end());
+        }
+        add("decision", name, fittest / generations, "fitness");
+        delete handler;
+    }
+
+    void breed(unsigned size) {
+        NetworkHandler* handler = new_handler(size);
+        handler->evaluate(32, 0, 22, HEIGHT, 20000); //fills the fittest networks to breed from
+        double generations = rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                handler->clear();
+                handler->breed_new_generation();
+            }
+        });
+        add("breed", to_string(size) + " paddles", 1000.0 / generations, "ms/generation");
+        delete handler;
+    }
+
+    //crossover and mutation of two genomes of length genes at the default mutation rate
+    void genetics(unsigned length) {
+        Random rng(seed);
+        vector<float> a(length), b(length), child(length);
+        for (unsigned i = 0; i < length; ++i) {
+            a[i] = rng.uniform(-1, 1);
+            b[i] = rng.uniform(-1, 1);
+        }
+        volatile float sink = 0;
+        double children = rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                Genetics::breed(a.data(), b.data(), child.data(), length, MUTATION_RATE, rng);
+            }
+            sink = sink + child[0];
+        });
+        add("breed", to_string(length) + " genes", children, "children/s");
+    }
+
+    void save_load(unsigned size) {
+        Random rng(seed);
+        NetworkParams params(INPUTS, OUTPUTS, HIDDEN_LAYERS, HIDDEN_LAYER_SIZE);
+        vector<NeuralNetwork*> networks;
+        vector<const float*> genomes;
+        vector<float> fitness;
+        for (unsigned i = 0; i < size; ++i) {
+            networks.push_back(new NeuralNetwork(params, rng));
+            genomes.push_back(networks.back()->get_genome());
+            fitness.push_back(i);
+        }
+        GenomeFile::Header header = networks.at(0)->header(0);
+        const char* path = "benchmark_population.genome.tmp";
+        double file_mb = (GenomeFile::HEADER_SIZE + size * (4 + header.genome_length * 4.0)) / 1e6;
+
+        double writes = rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                GenomeFile::write(path, header, genomes, fitness);
+            }
+        });
+        add("save", to_string(size) + " genomes", writes * size, "genomes/s");
+        add("save", to_string(size) + " genomes", writes * file_mb, "MB/s");
+
+        GenomeFile::Header read_header;
+        vector<float> read_genomes;
+        vector<float> read_fitness;
+        double reads = rate([&](unsigned long long reps) {
+            for (unsigned long long r = 0; r < reps; ++r) {
+                GenomeFile::read(path, read_header, read_genomes, read_fitness);
+            }
+        });
+        add("load", to_string(size) + " genomes", reads * size, "genomes/s");
+        add("load", to_string(size) + " genomes", reads * file_mb, "MB/s");
+
+        remove(path);
+        for (unsigned i = 0; i < networks.size(); ++i) {
+            delete networks.at(i);
+        }
+    }
+};
+
+int main(int argc, char * argv[]) {
+    bool csv = false;
+    string out_path;
+    double seconds = 0.5;
+    unsigned seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--csv") {
+            csv = true;
+        }
+        else if (arg == "--out" && i + 1 < argc) {
+            out_path = argv[++i];
+        }
+        else if (arg == "--seconds" && i + 1 < argc) {
+            seconds = atof(argv[++i]);
+        }
+        else if (arg == "--seed" && i + 1 < argc) {
+            seed = strtoul(argv[++i], nullptr, 10);
+        }
+        else {
+            cerr << "usage: benchmark [--csv] [--out file] [--seconds s] [--seed seed]" << endl;
+            return 1;
+        }
+    }
+
+    //the handlers print every generation, which would end up in the results
+    stringstream discarded;
+    streambuf* console = cout.rdbuf(discarded.rdbuf());
+    Benchmarks benchmarks(seconds, seed);
+    benchmarks.run();
+    cout.rdbuf(console);
+
+    string report = csv ? to_csv(benchmarks.get_results()) : to_json(benchmarks.get_results(), seed);
+    if (out_path.empty()) {
+        cout << report;
+        return 0;
+    }
+    ofstream fout(out_path);
+    if (!fout.is_open()) {
+        cerr << "could not open file: " << out_path << endl;
+        return 1;
+    }
+    fout << report;
+    return 0;
+}
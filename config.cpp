@@ -0,0 +1,255 @@
+#include "config.hpp"
+#include "NeuralNetwork/Random.hpp"
+
+#include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace std;
+
+//every key in the order to_string() and usage() list them
+static const char* KEYS[] = {
+    "inputs", "outputs", "hidden_layers", "hidden_layer_size",
+    "population", "mutation_rate", "num_fittest", "num_rendered",
+    "paddle_speed", "ball_speed", "height_ratio",
+    "checkpoint_interval", "evaluation_frames", "seed",
+    "islands", "migration_interval", "migrants", "threads", "steady_state", "decision_interval"
+};
+
+static bool parse_number(const string & value, unsigned long long max, unsigned long long & out) {
+    if (value.empty() || value[0] == '-' || value[0] == '+') {
+        return false;
+    }
+    errno = 0;
+    char* end;
+    out = strtoull(value.c_str(), &end, 10);
+    return errno == 0 && *end == '\0' && out <= max;
+}
+
+static bool parse_number(const string & value, unsigned & out) {
+    unsigned long long number;
+    if (!parse_number(value, UINT_MAX, number)) {
+        return false;
+    }
+    out = number;
+    return true;
+}
+
+static bool parse_number(const string & value, double & out) {
+    if (value.empty()) {
+        return false;
+    }
+    errno = 0;
+    char* end;
+    out = strtod(value.c_str(), &end);
+    return errno == 0 && *end == '\0' && isfinite(out);
+}
+
+//the shortest decimal that reads back as the same float or double
+template<typename T>
+static string format(T value) {
+    for (int precision = 6; ; ++precision) {
+        ostringstream out;
+        out.precision(precision);
+        out << value;
+        if ((T)strtod(out.str().c_str(), nullptr) == value || precision >= 17) {
+            return out.str();
+        }
+    }
+}
+
+static string trim(const string & s) {
+    size_t begin = s.find_first_not_of(" \t\r");
+    if (begin == string::npos) {
+        return "";
+    }
+    size_t end = s.find_last_not_of(" \t\r");
+    return s.substr(begin, end - begin + 1);
+}
+
+Config::Config():
+topology(INPUTS, OUTPUTS, HIDDEN_LAYERS, HIDDEN_LAYER_SIZE), population(POPULATION), mutation_rate(MUTATION_RATE),
+num_fittest(NUM_FITTEST), num_rendered(NUM_RENDERED_AIS), paddle_speed(SPEED), ball_speed(BALL_SPEED), height_ratio(HEIGHT_RATIO),
+checkpoint_interval(CHECKPOINT_INTERVAL), evaluation_frames(EVALUATION_FRAMES), seed(Random::entropy()),
+islands(ISLANDS), migration_interval(MIGRATION_INTERVAL), migrants(MIGRANTS), threads(THREADS), steady_state(STEADY_STATE),
+decision_interval(DECISION_INTERVAL) {}
+
+bool Config::set(const string & key, const string & value) {
+    unsigned number;
+    double real;
+    if (key == "inputs") { //Sensor only has readings for 3 to 6 inputs
+        if (!parse_number(value, number) || number < 3 || number > 6) return false;
+        topology.inputs = number;
+    }
+    else if (key == "outputs") { //up, down and stay
+        if (!parse_number(value, number) || number != NUM_OUTPUTS) return false;
+        topology.outputs = number;
+    }
+    else if (key == "hidden_layers") {
+        if (!parse_number(value, number) || number == 0) return false;
+        topology.hidden_layers = number;
+    }
+    else if (key == "hidden_layer_size") {
+        if (!parse_number(value, number) || number == 0) return false;
+        topology.hidden_layer_size = number;
+    }
+    else if (key == "population") {
+        if (!parse_number(value, number) || number == 0) return false;
+        population = number;
+    }
+    else if (key == "mutation_rate") {
+        if (!parse_number(value, real) || real < 0 || real > 1) return false;
+        mutation_rate = real;
+    }
+    else if (key == "num_fittest") {
+        if (!parse_number(value, number) || number == 0) return false;
+        num_fittest = number;
+    }
+    else if (key == "num_rendered") {
+        if (!parse_number(value, number)) return false;
+        num_rendered = number;
+    }
+    else if (key == "paddle_speed") {
+        if (!parse_number(value, real) || real <= 0) return false;
+        paddle_speed = real;
+    }
+    else if (key == "ball_speed") {
+        if (!parse_number(value, real) || real <= 0) return false;
+        ball_speed = real;
+    }
+    else if (key == "height_ratio") {
+        if (!parse_number(value, real) || real < 1) return false;
+        height_ratio = real;
+    }
+    else if (key == "checkpoint_interval") {
+        if (!parse_number(value, number)) return false;
+        checkpoint_interval = number;
+    }
+    else if (key == "evaluation_frames") {
+        unsigned long long frames;
+        if (!parse_number(value, ULLONG_MAX, frames)) return false;
+        evaluation_frames = frames;
+    }
+    else if (key == "seed") {
+        if (!parse_number(value, number)) return false;
+        seed = number;
+    }
+    else if (key == "islands") {
+        if (!parse_number(value, number) || number == 0) return false;
+        islands = number;
+    }
+    else if (key == "migration_interval") {
+        if (!parse_number(value, number)) return false;
+        migration_interval = number;
+    }
+    else if (key == "migrants") {
+        if (!parse_number(value, number)) return false;
+        migrants = number;
+    }
+    else if (key == "threads") {
+        if (!parse_number(value, number)) return false;
+        threads = number;
+    }
+    else if (key == "steady_state") { //0 or 1
+        if (!parse_number(value, number) || number > 1) return false;
+        steady_state = number;
+    }
+    else if (key == "decision_interval") {
+        if (!parse_number(value, number) || number == 0) return false;
+        decision_interval = number;
+    }
+    else {
+        return false;
+    }
+    return true;
+}
+
+bool Config::load(const string & path) {
+    ifstream in(path);
+    if (!in) {
+        cerr << "could not open config file: " << path << endl;
+        return false;
+    }
+    string line;
+    unsigned line_number = 0;
+    while (getline(in, line)) {
+        ++line_number;
+        size_t comment = line.find('#');
+        if (comment != string::npos) {
+            line.erase(comment);
+        }
+        line = trim(line);
+        if (line.empty()) {
+            continue;
+        }
+        size_t equals = line.find('=');
+        string key = equals == string::npos ? line : trim(line.substr(0, equals));
+        string value = equals == string::npos ? "" : trim(line.substr(equals + 1));
+        if (equals == string::npos || !set(key, value)) {
+            cerr << path << ':' << line_number << ": bad option: " << line << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Config::parse(int argc, char * argv[], vector<string> & args) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg.size() <= 2 || arg.compare(0, 2, "--") != 0) {
+            args.push_back(arg);
+            continue;
+        }
+        if (i + 1 >= argc) {
+            cerr << arg << " needs a value" << endl;
+            return false;
+        }
+        string key = arg.substr(2);
+        string value = argv[++i];
+        if (key == "config") {
+            if (!load(value)) {
+                return false;
+            }
+        }
+        else if (!set(key, value)) {
+            cerr << "bad option: " << arg << ' ' << value << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+string Config::to_string() const {
+    const string values[] = {
+        std::to_string(topology.inputs), std::to_string(topology.outputs), std::to_string(topology.hidden_layers), std::to_string(topology.hidden_layer_size),
+        std::to_string(population), format(mutation_rate), std::to_string(num_fittest), std::to_string(num_rendered),
+        format(paddle_speed), format(ball_speed), format(height_ratio),
+        std::to_string(checkpoint_interval), std::to_string(evaluation_frames), std::to_string(seed),
+        std::to_string(islands), std::to_string(migration_interval), std::to_string(migrants), std::to_string(threads),
+        std::to_string(steady_state), std::to_string(decision_interval)
+    };
+    string out;
+    for (unsigned i = 0; i < sizeof(KEYS) / sizeof(KEYS[0]); ++i) {
+        out += string(KEYS[i]) + " = " + values[i] + "\n";
+    }
+    return out;
+}
+
+string Config::usage() {
+    //the defaults, with a random seed
+    istringstream defaults(Config().to_string());
+    string out = "options (--key value, or key = value lines in a --config file):\n";
+    string line;
+    while (getline(defaults, line)) {
+        size_t equals = line.find(" = ");
+        string key = line.substr(0, equals);
+        string value = key == "seed" ? "random" : line.substr(equals + 3);
+        out += "  --" + key + string(key.size() < 20 ? 20 - key.size() : 1, ' ') + "default " + value + "\n";
+    }
+    out += "  --config <file>\n";
+    return out;
+}
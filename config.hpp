@@ -0,0 +1,58 @@
+#ifndef __CONFIG_HPP__
+#define __CONFIG_HPP__
+
+#include "definitions.hpp"
+#include "NeuralNetwork/NeuralNetwork.hpp"
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// Everything a run can be tuned with, starting from the defaults in definitions.hpp.
+// It is read from `--key value` flags or a file of `key = value` lines (# starts a
+// comment), so a parameter sweep is a loop over command lines instead of rebuilds:
+//
+//   trainer 200 --population 2000 --mutation_rate 0.02 --seed 7
+//   trainer 200 --config sweep.cfg --hidden_layer_size 8
+//
+// flags and files are applied in order, later ones win
+struct Config {
+    NetworkParams topology;
+    unsigned population;          //networks per generation
+    float mutation_rate;
+    unsigned num_fittest;         //how many networks are kept for breeding
+    unsigned num_rendered;        //how many pairs Train draws at a time
+    double paddle_speed;
+    double ball_speed;            //also what the sensors scale ball velocities by
+    float height_ratio;           //paddles are HEIGHT / height_ratio tall
+    unsigned checkpoint_interval; //generations between checkpoints of a headless run
+    unsigned long long evaluation_frames; //frames a headless generation may last, 0 has no limit
+    unsigned seed;                //a run with the same seed makes the same random choices
+    unsigned islands;             //populations evolved side by side, see IslandModel
+    unsigned migration_interval;  //generations between migrations, 0 never migrates
+    unsigned migrants;            //networks each island sends to the next one
+    unsigned threads;             //threads a population is stepped on, 0 uses every core
+    bool steady_state;            //dead pairs are replaced right away, a generation is population births
+    unsigned decision_interval;   //networks decide every decision_interval frames and repeat their move in between
+
+    Config();
+
+    //sets one option, returns false if the key is unknown or the value doesn't fit it
+    bool set(const string & key, const string & value);
+
+    //applies every `key = value` line of the file, returns false if it can't be read or a line is wrong
+    bool load(const string & path);
+
+    //applies `--key value` and `--config file` in order. everything else is appended to args.
+    //returns false, after printing why, on an unknown flag or a bad value
+    bool parse(int argc, char * argv[], vector<string> & args);
+
+    //every option as `key = value` lines, load() reads it back
+    string to_string() const;
+
+    //the options and their defaults, for a program's usage message
+    static string usage();
+};
+
+#endif
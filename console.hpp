@@ -0,0 +1,77 @@
+#ifndef __CONSOLE_HPP__
+#define __CONSOLE_HPP__
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// The console calls the game makes, on the windows console or an ANSI terminal.
+
+//windows console colors:
+// Black        |   0       Dark Gray    |   8
+// Blue         |   1       Light Blue   |   9
+// Green        |   2       Light Green  |   10
+// Cyan         |   3       Light Cyan   |   11
+// Red          |   4       Light Red    |   12
+// Magenta      |   5       Light Magenta|   13
+// Brown        |   6       Yellow       |   14
+// Light Gray   |   7       White        |   15
+inline void SetColor(int ForgC) {
+#ifdef _WIN32
+    WORD wColor;
+
+    HANDLE hStdOut = GetStdHandle(STD_OUTPUT_HANDLE);
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+
+    if(GetConsoleScreenBufferInfo(hStdOut, &csbi)) {
+        wColor = (csbi.wAttributes & 0xF0) + (ForgC & 0x0F);
+        SetConsoleTextAttribute(hStdOut, wColor);
+    }
+#else
+    if (!isatty(fileno(stdout))) { //no escape codes in logs
+        return;
+    }
+    //the console stores blue green red, ANSI red green blue
+    int color = ((ForgC & 1) << 2) | (ForgC & 2) | ((ForgC & 4) >> 2);
+    std::cout << "\033[" << ((ForgC & 8) ? 90 + color : 30 + color) << 'm' << std::flush;
+#endif
+    return;
+}
+
+inline void clear_screen() {
+#ifdef _WIN32
+    system("CLS");
+#else
+    if (isatty(fileno(stdout))) {
+        std::cout << "\033[2J\033[H" << std::flush;
+    }
+#endif
+}
+
+//waits for enter, so a console window started by double clicking stays open
+inline void wait_for_key() {
+#ifdef _WIN32
+    system("PAUSE");
+#else
+    if (isatty(fileno(stdin))) {
+        std::cout << "Press enter to continue . . ." << std::endl;
+        std::cin.ignore(std::cin.rdbuf()->in_avail()); //whatever is left of the last answer
+        std::cin.get();
+    }
+#endif
+}
+
+inline void sleep_ms(unsigned ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+#endif
@@ -0,0 +1,106 @@
+//cmake --build build --target convert_saves    (see Building in the README)
+
+// Converts text saves to the binary genome format.
+//
+//   convert_saves [files or directories...]     (default: ../saves)
+//
+// Every text save found is written next to itself as <name>.genome, the fitness
+// is taken from the "score" part of its name. Binary files and anything that is
+// not a save are skipped.
+
+#include "NeuralNetwork/NeuralNetwork.hpp"
+#include "NeuralNetwork/GenomeFile.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+unsigned score_from_name(string name);
+bool is_text_save(string path);
+bool convert(string path);
+
+int main(int argc, char * argv[]) {
+    vector<string> paths;
+    for (int i = 1; i < argc; ++i) {
+        paths.push_back(argv[i]);
+    }
+    if (paths.empty()) {
+        paths.push_back("../saves");
+    }
+
+    unsigned converted = 0;
+    unsigned failed = 0;
+    for (unsigned i = 0; i < paths.size(); ++i) {
+        vector<string> files;
+        if (filesystem::is_directory(paths.at(i))) {
+            for (const filesystem::directory_entry & entry : filesystem::recursive_directory_iterator(paths.at(i))) {
+                if (entry.is_regular_file() && entry.path().extension() != ".genome") {
+                    files.push_back(entry.path().string());
+                }
+            }
+        }
+        else {
+            files.push_back(paths.at(i));
+        }
+
+        for (unsigned j = 0; j < files.size(); ++j) {
+            if (GenomeFile::is_binary(files.at(j)) || !is_text_save(files.at(j))) {
+                continue;
+            }
+            if (convert(files.at(j))) {
+                ++converted;
+            }
+            else {
+                ++failed;
+            }
+        }
+    }
+
+    cout << "converted " << converted << " saves, " << failed << " failed" << endl;
+    return failed == 0 ? 0 : 1;
+}
+
+//"3_3_1_5_score748_xt75k0v150" -> 748
+unsigned score_from_name(string name) {
+    size_t start = name.find("score");
+    if (start == string::npos) {
+        return 0;
+    }
+    return strtoul(name.c_str() + start + 5, nullptr, 10);
+}
+
+//text saves start with the topology: inputs outputs hidden_layers hidden_layer_size
+bool is_text_save(string path) {
+    ifstream fin(path);
+    unsigned topology[4];
+    for (unsigned i = 0; i < 4; ++i) {
+        if (!(fin >> topology[i])) {
+            return false;
+        }
+    }
+    return topology[0] > 0 && topology[1] > 0 && topology[2] > 0 && topology[3] > 0;
+}
+
+bool convert(string path) {
+    NeuralNetwork nn(path);
+
+    string name = filesystem::path(path).filename().string();
+    vector<const float*> genomes(1, nn.get_genome());
+    vector<float> fitness(1, (float)score_from_name(name));
+    if (!GenomeFile::write(path + ".genome", nn.header(0), genomes, fitness)) {
+        return false;
+    }
+
+    //the text save has to load back to the same genes
+    NeuralNetwork check(path + ".genome");
+    if (!(check == nn)) {
+        cout << "converted file does not match: " << path << endl;
+        return false;
+    }
+    cout << path << ".genome" << endl;
+    return true;
+}
@@ -0,0 +1,120 @@
+//cmake --build build --target core_tests    (see Building in the README)
+
+// The tests that don't need SDL to run: matrices, networks and training.
+// all_tests runs these and the tests of everything that draws or reads the keyboard.
+
+#include "Tests/tests.hpp"
+#include "Tests/matrix_tests.hpp"
+#include "Tests/network_handler_tests.hpp"
+#include "Tests/neural_network_tests.hpp"
+#include "Tests/fixed_network_tests.hpp"
+#include "Tests/genetics_tests.hpp"
+#include "Tests/config_tests.hpp"
+#include "Tests/island_model_tests.hpp"
+#include "Tests/intercept_tests.hpp"
+#include "Tests/benchmark_report_tests.hpp"
+
+
+int main() {
+    Tests* test;
+    int tot_passed = 0;
+    int tot_failed = 0;
+
+    SetColor(14);
+    cout << "Performing Matrix Class Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new MatrixTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing Network Handler Class Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new NHTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing Neural_Network Class Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new NeuralNetworkTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing FixedNetwork Class Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new FixedNetworkTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing Genetics Class Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new GeneticsTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing Config Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new ConfigTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing IslandModel Class Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new IslandModelTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing Intercept Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new InterceptTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(14);
+    cout << "Performing Benchmark Report Tests . . ." << endl << endl;
+    SetColor(7);
+    test = new BenchmarkReportTests();
+    test->run_tests();
+    tot_passed += test->passed;
+    tot_failed += test->failed;
+    delete test;
+    cout << endl << "======================================================================================" << endl << endl;
+
+    SetColor(2);
+    cout << "TOTAL PASSED: " << tot_passed << endl;
+    SetColor(4);
+    cout << "TOTAL FAILED: " << tot_failed << endl;
+    SetColor(7);
+
+    return tot_failed == 0 ? 0 : 1;
+}
@@ -1,24 +1,23 @@
 #ifndef __DEFINITIONS_H__
 #define __DEFINITIONS_H__
 
-#include "SDL2/SDL.h"
-#include "SDL2/SDL_ttf.h"
-
 //------------------------------------------------------------------------------------------------------
-// 32 bit compile command:
-//g++ program.cpp -ISDL2-mingw32\include -L SDL2-mingw32\lib -w -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -o compile/program
-
-// 64 bit compile command:
-//g++ program.cpp -Isdl2lib\include -Lsdl2lib\lib -w -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -o compile/program
+// build with CMake, see the README:
+//   cmake -S . -B build && cmake --build build
+//
+// these are the defaults of a run. a Config (config.hpp) starts from them and can
+// override most of them from the command line or a config file without rebuilding
+//
 
 //
 // CONTROL OPTIONS
 //
-// controls begin with: "SDL_SCANCODE_" and end with the desired letter
+// controls are SDL scancodes: "SDL_SCANCODE_" followed by the desired letter
 // arrow keys: SDL_SCANCODE_UP, SDL_SCANCODE_DOWN, SDL_SCANCODE_LEFT, SDL_SCANCODE_RIGHT
+// (see SDL2/SDL_scancode.h, the values are written out so the core builds without SDL)
 //
-unsigned PLAYER_UP = SDL_SCANCODE_A;
-unsigned PLAYER_DOWN = SDL_SCANCODE_D;
+const unsigned PLAYER_UP = 4;   //SDL_SCANCODE_A
+const unsigned PLAYER_DOWN = 7; //SDL_SCANCODE_D
 //
 
 
@@ -27,15 +26,26 @@ unsigned PLAYER_DOWN = SDL_SCANCODE_D;
 //
 // note: these values dont effect the game options for the predetermined
 //       difficulties
-double SPEED = 9.0;
-double BALL_SPEED = 14;
+const double SPEED = 9.0;
+const double BALL_SPEED = 14;
+const float HEIGHT_RATIO = 8; //paddles are HEIGHT / HEIGHT_RATIO tall
 //
 
 //
 // Evolutionary definitions
 //
-unsigned NUM_FITTEST = 20; //how many players are selected for breeding
-unsigned NUM_RENDERED_AIS = 5; //how many players are rendered at a time
+const unsigned POPULATION = 1200; //networks per generation
+const float MUTATION_RATE = 0.05;
+const unsigned NUM_FITTEST = 20; //how many players are selected for breeding
+const unsigned NUM_RENDERED_AIS = 5; //how many players are rendered at a time
+const unsigned CHECKPOINT_INTERVAL = 10; //generations between checkpoints of a headless run
+const unsigned long long EVALUATION_FRAMES = 1000000; //frames a headless generation may last before its survivors are scored, 0 has no limit
+const unsigned ISLANDS = 1; //populations trainer evolves side by side, the population is split between them
+const unsigned MIGRATION_INTERVAL = 10; //generations between migrations from island to island, 0 never migrates
+const unsigned MIGRANTS = 2; //how many of an island's fittest networks migrate to the next island
+const unsigned THREADS = 0; //threads each population is stepped on, 0 uses every core
+const bool STEADY_STATE = false; //refill a dead paddle's slot right away instead of waiting for the whole generation
+const unsigned DECISION_INTERVAL = 1; //frames a network's move is repeated for before it is asked again, 1 asks every frame
 //
 
 
@@ -62,8 +72,8 @@ const unsigned HIDDEN_LAYER_SIZE = 5;
 // DONT CHANGE
 //
 const unsigned NUM_OUTPUTS = 3;
-int HEIGHT = 720;
-int WIDTH = 1280;
-double PI = 3.14159265358979323846;
+const int HEIGHT = 720;
+const int WIDTH = 1280;
+const double PI = 3.14159265358979323846;
 
 #endif
@@ -1,5 +1,4 @@
-//g++ program.cpp -Isdl2lib\include -Lsdl2lib\lib -w -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -o compile/program
-//g++ program.cpp -ISDL2-mingw32\include -L SDL2-mingw32\lib -w -lmingw32 -lSDL2main -lSDL2 -lSDL2_ttf -o compile/program
+//cmake --build build --target program    (see Building in the README)
 
 #include "SDL2/SDL.h"
 #include "SDL2/SDL_ttf.h"
@@ -7,38 +6,72 @@
 #include "Gamemode/Gamemode.hpp"
 #include "Gamemode/Train.hpp"
 #include "Gamemode/Play.hpp"
+#include "config.hpp"
+
+#include "console.hpp"
 
 #include <stdio.h>
 #include <stdlib.h>
-#include <windows.h>
-#include <io.h>
 #include <iostream>
 #include <cstring>
+#include <string>
+#include <vector>
 
 using namespace std;
 
-void SetColor(int);
-
 string PlayInput();
 
 char intro();
 
 int main(int argc, char * argv[]) {
 
+    // headless training: program --headless [number of generations] [checkpoint file] [--key value ...] [--config file]
+    // the game itself takes the same options: program [--key value ...] [--config file]
+    bool headless = argc > 1 && strcmp(argv[1], "--headless") == 0;
+    Config config;
+    vector<string> args;
+    if (!config.parse(argc - headless, argv + headless, args)) { //parse() skips the first argument, which is then --headless
+        cerr << "program [--headless [generations] [checkpoint file]] [options]" << endl << Config::usage();
+        return 1;
+    }
+    if (headless) {
+        unsigned max_generations = 0;
+        if (args.size() > 0) {
+            max_generations = strtoul(args.at(0).c_str(), nullptr, 10);
+        }
+        string checkpoint_path;
+        if (args.size() > 1) {
+            checkpoint_path = args.at(1);
+        }
+        cout << config.to_string();
+
+        Gamemode* game = new Train(config, true, max_generations, checkpoint_path);
+        bool running = true;
+        while (running) {
+            game->update(running);
+        }
+        delete game;
+        return 0;
+    }
+
     char input = intro();
 
     Gamemode* game;
     if (input == '2') {
-        game = new Train();
+        if (config.islands > 1) { //islands can't all be drawn
+            cerr << "--islands needs --headless, rendered training plays one population" << endl;
+            return 1;
+        }
+        game = new Train(config);
     }
     else if (input == '1') {
-        game = new Play(PlayInput());
+        game = new Play(PlayInput(), config);
     }
     else {
         throw("unexpected entry");
     }
 
-    system("CLS");
+    clear_screen();
 
     bool running = true;
     while (running) {
@@ -47,12 +80,12 @@ int main(int argc, char * argv[]) {
 
     delete game;
     SetColor(7);
-    system("PAUSE");
+    wait_for_key();
     return 0;
 }
 
 string PlayInput() {
-    system("CLS");
+    clear_screen();
     SetColor(15);
     cout << endl;
     cout << "Welcome to User vs. Player" << endl;
@@ -101,7 +134,7 @@ char intro() {
 
     for (unsigned i = 0; i < strlen(output); ++i) {
         cout << output[i];
-        Sleep(20);
+        sleep_ms(20);
     }
 
     char input;
@@ -139,18 +172,6 @@ char intro() {
 // Yellow       |   14
 // White        |   15
 
-void SetColor(int ForgC) {
-    WORD wColor;
-
-    HANDLE hStdOut = GetStdHandle(STD_OUTPUT_HANDLE);
-    CONSOLE_SCREEN_BUFFER_INFO csbi;
-
-    if(GetConsoleScreenBufferInfo(hStdOut, &csbi)) {
-        wColor = (csbi.wAttributes & 0xF0) + (ForgC & 0x0F);
-        SetConsoleTextAttribute(hStdOut, wColor);
-    }
-    return;
-}
 
 
 
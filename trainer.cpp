@@ -0,0 +1,64 @@
+//cmake --build build --target trainer    (see Building in the README)
+
+// Headless training without SDL, the same run as `program --headless` for machines
+// that only train.
+//
+//   trainer [generations] [checkpoint file] [--key value ...] [--config file]     (0 generations: until stopped)
+//
+// every option of a run can be set without rebuilding, see config.hpp or `trainer --help`.
+// --islands n evolves n populations side by side, see IslandModel
+
+#include "definitions.hpp"
+#include "config.hpp"
+#include "NeuralNetwork/IslandModel.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char * argv[]) {
+    if (argc > 1 && (strcmp(argv[1], "--help") == 0 || strcmp(argv[1], "-h") == 0)) {
+        cout << "trainer [generations] [checkpoint file] [options]" << endl << Config::usage();
+        return 0;
+    }
+    Config config;
+    vector<string> args;
+    if (!config.parse(argc, argv, args)) {
+        cerr << "trainer [generations] [checkpoint file] [options]" << endl << Config::usage();
+        return 1;
+    }
+    unsigned max_generations = 0;
+    if (args.size() > 0) {
+        max_generations = strtoul(args.at(0).c_str(), nullptr, 10);
+    }
+    string checkpoint_path;
+    if (args.size() > 1) {
+        checkpoint_path = args.at(1);
+    }
+    cout << config.to_string();
+
+    IslandModel* model = new IslandModel(config); //a resumed run keeps the seed it was started with
+    if (checkpoint_path.empty() || !model->resume(checkpoint_path)) {
+        model->init_networks();
+    }
+    if (!checkpoint_path.empty()) {
+        model->set_checkpoint(checkpoint_path, config.checkpoint_interval);
+    }
+    model->serve();
+
+    //Train's left wall, which never moves without a player
+    while (max_generations == 0 || model->get_nth_generation() <= max_generations) {
+        model->evaluate(32, 0, 22, HEIGHT, config.evaluation_frames);
+    }
+
+    if (!checkpoint_path.empty()) {
+        model->checkpoint(checkpoint_path);
+    }
+    model->save(config.num_fittest);
+    delete model; //waits for the last checkpoints
+    return 0;
+}